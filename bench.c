@@ -0,0 +1,543 @@
+#include "snake.h"
+#include "layer.h"
+#include "lod.h"
+#include "minimap.h"
+#include "particles.h"
+
+#define MAX_ITERATIONS 100000000
+#define BENCH_TARGET_WIDTH 1920
+#define BENCH_TARGET_HEIGHT 1080
+#define MAX_TRIALS 64
+#define MAX_RESULTS 256
+#define BOOTSTRAP_RESAMPLES 2000
+#define BENCH_PARTICLES 100000
+
+typedef struct _Scenario{
+    const char *name;
+    int columns;
+    int rows;
+    int length;
+}Scenario;
+
+typedef struct _Result{
+    char scenario[64];
+    char operation[32];
+    int count;
+    double samples[MAX_TRIALS];
+}Result;
+
+typedef struct _Bench{
+    Renderer *renderer;
+    RenderState *state;
+    Texture *target;
+    Atlas *atlas;
+    SnakeLayer *layer;
+    RenderQueue *queue;
+    Snake *snake;
+    Vector2 point;
+    Camera camera;
+    LevelOfDetail *lod;
+    Minimap *minimap;
+    unsigned int seed;
+    int length;
+    Particles *particles;
+    double min_seconds;
+    int trials;
+    Result *results;
+    int results_count;
+}Bench;
+
+static const Scenario scenarios[] = {
+    {"empty_30x30",30,30,4},
+    {"fill50_30x30",30,30,450},
+    {"fill95_30x30",30,30,855},
+    {"empty_256x256",256,256,4},
+    {"fill50_256x256",256,256,32768},
+    {"fill95_256x256",256,256,62259},
+    {"length1M_1024x1024",1024,1024,1000000},
+    {"empty_4096x4096",4096,4096,4},
+    {"length1M_4096x4096",4096,4096,1000000},
+};
+
+typedef void (*Operation)(Bench *bench);
+
+double GetSeconds(uint64_t start,uint64_t end){
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+//the zigzag snake of snake.c already moving along its row
+Snake* CreateBenchSnake(int length){
+    Snake *snake = CreateSnakeOfLength(length);
+
+    int head_row = (length - 2) / columns;
+    snake->buffer_direction = (Vector2){(head_row % 2 == 0) ? 1.0f : -1.0f,0.0f};
+    snake->moving = true;
+    SnakeNextMove(snake);
+
+    return snake;
+}
+
+//every trial starts from the same snake and food with the generator reseeded,
+//so the operations that move the snake measure the same steps in each sample
+void BenchResetSnake(Bench *bench){
+    if(bench->snake != NULL) SnakeFree(bench->snake);
+    srand(bench->seed);
+    GetPointPosition(&bench->point);
+    bench->snake = CreateBenchSnake(bench->length);
+}
+
+void BenchResetMinimap(Bench *bench){
+    BenchResetSnake(bench);
+    MinimapRebuild(bench->minimap,bench->snake,&bench->point,bench->atlas);
+}
+
+void BenchResetLayer(Bench *bench){
+    BenchResetSnake(bench);
+    SnakeLayerRebuild(bench->layer,bench->renderer,bench->snake,bench->atlas);
+}
+
+void BenchSnakeMove(Bench *bench){
+    SnakeMove(bench->snake,&bench->point,1.0f / 60.0f);
+}
+
+//a 60 fps frame at the highest time scale, every step of it simulated
+void BenchSnakeAdvance(Bench *bench){
+    Vector2 food;
+    SnakeAdvance(bench->snake,&bench->point,(float)MAX_TIME_SCALE / 60.0f,&food);
+}
+
+void BenchPutTailOnHead(Bench *bench){
+    PutTailOnHead(bench->snake);
+}
+
+void BenchGetPointPosition(Bench *bench){
+    GetPointPosition(&bench->point);
+}
+
+void BenchDrawFloor(Bench *bench){
+    DrawFloor(bench->queue,&bench->camera,bench->atlas);
+    RenderQueueFlush(bench->queue,bench->state);
+    FlushBlitBuffer(bench->renderer);
+}
+
+void BenchDrawObjects(Bench *bench){
+    DrawObjects(bench->queue,bench->snake,&bench->point,&bench->camera,bench->atlas);
+    RenderQueueFlush(bench->queue,bench->state);
+    FlushBlitBuffer(bench->renderer);
+}
+
+void BenchDrawDiamonds(Bench *bench){
+    DrawDiamonds(bench->renderer,bench->lod,bench->snake,&bench->point,&bench->camera,bench->atlas);
+    FlushBlitBuffer(bench->renderer);
+}
+
+void BenchDrawBoardQuad(Bench *bench){
+    DrawBoardQuad(bench->renderer,bench->minimap->texture,&bench->camera);
+    FlushBlitBuffer(bench->renderer);
+}
+
+void BenchMinimapRebuild(Bench *bench){
+    MinimapRebuild(bench->minimap,bench->snake,&bench->point,bench->atlas);
+}
+
+//one full step per call, the minimap follows it with a handful of texels
+void BenchMinimapUpdate(Bench *bench){
+    SnakeMove(bench->snake,&bench->point,(float)TILE_SIZE / VELOCITY);
+    MinimapUpdate(bench->minimap,bench->snake,&bench->point,bench->atlas);
+}
+
+//one full step per call, so every frame pays for a layer update
+void BenchDrawSnakeLayer(Bench *bench){
+    SnakeMove(bench->snake,&bench->point,(float)TILE_SIZE / VELOCITY);
+    SnakeLayerUpdate(bench->layer,bench->renderer,bench->snake,bench->atlas);
+    DrawSnakeLayer(bench->renderer,bench->layer,bench->snake,&bench->point,&bench->camera,bench->atlas);
+    FlushBlitBuffer(bench->renderer);
+}
+
+void BenchParticlesUpdate(Bench *bench){
+    ParticlesUpdate(bench->particles,1.0f / 60.0f);
+}
+
+void BenchDrawParticles(Bench *bench){
+    DrawParticles(bench->renderer,bench->particles,&bench->camera);
+    FlushBlitBuffer(bench->renderer);
+}
+
+//a full pool of resting particles spread over the board that outlive the measurement
+Particles* CreateBenchParticles(){
+    Particles *particles = CreateParticles(PARTICLE_CAPACITY);
+    Color color = {200,150,0,255};
+    for(int i=0; i<BENCH_PARTICLES; ++i){
+        Vector2 position = {(rand() % columns) * TILE_SIZE,(rand() % rows) * TILE_SIZE};
+        EmitParticles(particles,position,1,0.0f,1e9f,color);
+    }
+    return particles;
+}
+
+double TimeOperation(Bench *bench,Operation operation){
+    uint64_t start = SDL_GetPerformanceCounter();
+    uint64_t end = start;
+    long iterations = 0;
+    long batch = 1;
+
+    //the batch doubles so the counter is read rarely for the cheap operations
+    while(iterations < MAX_ITERATIONS && GetSeconds(start,end) < bench->min_seconds){
+        for(long i=0; i<batch; ++i){
+            operation(bench);
+        }
+        iterations += batch;
+        batch *= 2;
+        end = SDL_GetPerformanceCounter();
+    }
+
+    return GetSeconds(start,end) * 1e9 / iterations;
+}
+
+int CompareDouble(const void *a,const void *b){
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+double GetMedian(const double *samples,int count){
+    double sorted[MAX_TRIALS];
+    memcpy(sorted,samples,sizeof(double) * count);
+    qsort(sorted,count,sizeof(double),CompareDouble);
+    return (count % 2) ? sorted[count/2] : (sorted[count/2-1] + sorted[count/2]) * 0.5;
+}
+
+//reset runs before each trial and may be NULL for the operations that change nothing
+void RunOperation(Bench *bench,const Scenario *scenario,const char *name,Operation reset,Operation operation){
+    if(bench->results_count >= MAX_RESULTS) return;
+
+    Result *result = &bench->results[bench->results_count];
+    snprintf(result->scenario,sizeof(result->scenario),"%s",scenario->name);
+    snprintf(result->operation,sizeof(result->operation),"%s",name);
+    result->count = bench->trials;
+
+    for(int i=0; i<bench->trials; ++i){
+        if(reset != NULL) reset(bench);
+        result->samples[i] = TimeOperation(bench,operation);
+    }
+
+    printf("%s\n    {\"scenario\":\"%s\",\"columns\":%d,\"rows\":%d,\"length\":%d,\"operation\":\"%s\",\"trials\":%d,\"ns_per_op\":%.3f,\"samples\":[",
+        bench->results_count ? "," : "",scenario->name,scenario->columns,scenario->rows,scenario->length,name,result->count,GetMedian(result->samples,result->count));
+    for(int i=0; i<result->count; ++i){
+        printf("%s%.3f",i ? "," : "",result->samples[i]);
+    }
+    printf("]}");
+    fflush(stdout);
+
+    bench->results_count++;
+}
+
+bool SaveBaseline(Bench *bench,const char *path){
+    FILE *file = fopen(path,"w");
+    if(file == NULL) return false;
+
+    fprintf(file,"# scenario operation trials samples(ns per op)...\n");
+    for(int i=0; i<bench->results_count; ++i){
+        Result *result = &bench->results[i];
+        fprintf(file,"%s %s %d",result->scenario,result->operation,result->count);
+        for(int j=0; j<result->count; ++j){
+            fprintf(file," %.3f",result->samples[j]);
+        }
+        fprintf(file,"\n");
+    }
+
+    fclose(file);
+    return true;
+}
+
+int LoadBaseline(const char *path,Result *results){
+    FILE *file = fopen(path,"r");
+    if(file == NULL) return -1;
+
+    int count = 0;
+    char line[4096];
+    while(count < MAX_RESULTS && fgets(line,sizeof(line),file) != NULL){
+        if(line[0] == '#') continue;
+
+        Result *result = &results[count];
+        int offset = 0;
+        if(sscanf(line,"%63s %31s %d%n",result->scenario,result->operation,&result->count,&offset) != 3) continue;
+        if(result->count < 1 || result->count > MAX_TRIALS) continue;
+
+        char *buffer = line + offset;
+        for(int i=0; i<result->count; ++i){
+            result->samples[i] = strtod(buffer,&buffer);
+        }
+        count++;
+    }
+
+    fclose(file);
+    return count;
+}
+
+//two-sided Mann-Whitney U test with the normal approximation and tie correction
+double MannWhitney(const double *a,int n1,const double *b,int n2){
+    int n = n1 + n2;
+    double values[MAX_TRIALS*2];
+    int groups[MAX_TRIALS*2];
+    for(int i=0; i<n; ++i){
+        values[i] = (i < n1) ? a[i] : b[i-n1];
+        groups[i] = (i < n1) ? 0 : 1;
+    }
+
+    //insertion sort keeps the groups next to their values
+    for(int i=1; i<n; ++i){
+        double value = values[i];
+        int group = groups[i];
+        int j = i - 1;
+        while(j >= 0 && values[j] > value){
+            values[j+1] = values[j];
+            groups[j+1] = groups[j];
+            j--;
+        }
+        values[j+1] = value;
+        groups[j+1] = group;
+    }
+
+    double rank_sum = 0.0;
+    double ties = 0.0;
+    for(int i=0; i<n;){
+        int j = i;
+        while(j+1 < n && values[j+1] == values[i]) j++;
+        double rank = (i + j) * 0.5 + 1.0;
+        for(int k=i; k<=j; ++k){
+            if(groups[k] == 0) rank_sum += rank;
+        }
+        double t = j - i + 1;
+        ties += t * t * t - t;
+        i = j + 1;
+    }
+
+    double u = rank_sum - n1 * (n1 + 1) * 0.5;
+    double mean = n1 * n2 * 0.5;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - ties / ((double)n * (n - 1)));
+    if(variance <= 0.0) return 1.0;
+
+    double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+    if(z < 0.0) z = 0.0;
+    return erfc(z / sqrt(2.0));
+}
+
+uint32_t NextRandom(uint32_t *state){
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+//95% percentile bootstrap interval of median(current) / median(baseline)
+void BootstrapRatio(const Result *baseline,const Result *current,double *low,double *high){
+    static double ratios[BOOTSTRAP_RESAMPLES];
+    double a[MAX_TRIALS];
+    double b[MAX_TRIALS];
+    uint32_t state = 2463534242u;
+
+    for(int i=0; i<BOOTSTRAP_RESAMPLES; ++i){
+        for(int j=0; j<baseline->count; ++j) a[j] = baseline->samples[NextRandom(&state) % baseline->count];
+        for(int j=0; j<current->count; ++j) b[j] = current->samples[NextRandom(&state) % current->count];
+        ratios[i] = GetMedian(b,current->count) / GetMedian(a,baseline->count);
+    }
+
+    qsort(ratios,BOOTSTRAP_RESAMPLES,sizeof(double),CompareDouble);
+    *low = ratios[(int)(BOOTSTRAP_RESAMPLES * 0.025)];
+    *high = ratios[(int)(BOOTSTRAP_RESAMPLES * 0.975)];
+}
+
+//prints the speedup table to stderr and returns the number of regressions
+int CompareBaseline(Bench *bench,Result *baseline,int baseline_count,double alpha,double threshold){
+    int regressions = 0;
+
+    fprintf(stderr,"\n%-22s %-18s %12s %12s %8s %17s %8s  %s\n","scenario","operation","base ns","ns","speedup","ratio 95% ci","p","verdict");
+
+    for(int i=0; i<bench->results_count; ++i){
+        Result *current = &bench->results[i];
+        Result *base = NULL;
+        for(int j=0; j<baseline_count; ++j){
+            if(strcmp(baseline[j].scenario,current->scenario) == 0 && strcmp(baseline[j].operation,current->operation) == 0){
+                base = &baseline[j];
+                break;
+            }
+        }
+
+        if(base == NULL){
+            fprintf(stderr,"%-22s %-18s %12s %12.3f %8s %17s %8s  %s\n",current->scenario,current->operation,"-",GetMedian(current->samples,current->count),"-","-","-","new");
+            continue;
+        }
+
+        double base_median = GetMedian(base->samples,base->count);
+        double median = GetMedian(current->samples,current->count);
+        double p = MannWhitney(base->samples,base->count,current->samples,current->count);
+        double low,high;
+        BootstrapRatio(base,current,&low,&high);
+
+        //a change is reported only when both the rank test and the interval agree and it exceeds the threshold
+        const char *verdict = "same";
+        if(p < alpha && low > 1.0 + threshold){
+            verdict = "REGRESSION";
+            regressions++;
+        }
+        else if(p < alpha && high < 1.0 - threshold){
+            verdict = "improvement";
+        }
+
+        fprintf(stderr,"%-22s %-18s %12.3f %12.3f %7.3fx    [%5.3f, %5.3f] %8.4f  %s\n",
+            current->scenario,current->operation,base_median,median,base_median / median,low,high,p,verdict);
+    }
+
+    return regressions;
+}
+
+void RunScenario(Bench *bench,const Scenario *scenario,unsigned int seed){
+    columns = scenario->columns;
+    rows = scenario->rows;
+    bench->seed = seed;
+    bench->length = scenario->length;
+    bench->camera.scale = 1.0f;
+    CameraCenter(&bench->camera,BENCH_TARGET_WIDTH,BENCH_TARGET_HEIGHT);
+
+    fprintf(stderr,"%s\n",scenario->name);
+
+    bench->snake = NULL;
+    RunOperation(bench,scenario,"SnakeMove",BenchResetSnake,BenchSnakeMove);
+    RunOperation(bench,scenario,"SnakeAdvance",BenchResetSnake,BenchSnakeAdvance);
+    RunOperation(bench,scenario,"PutTailOnHead",BenchResetSnake,BenchPutTailOnHead);
+    RunOperation(bench,scenario,"GetPointPosition",BenchResetSnake,BenchGetPointPosition);
+
+    BenchResetSnake(bench);
+
+    bench->particles = CreateBenchParticles();
+    RunOperation(bench,scenario,"ParticlesUpdate",NULL,BenchParticlesUpdate);
+
+    if(bench->renderer != NULL){
+        StateSetTarget(bench->state,bench->target);
+        RunOperation(bench,scenario,"DrawFloor",NULL,BenchDrawFloor);
+        RunOperation(bench,scenario,"DrawObjects",NULL,BenchDrawObjects);
+        RunOperation(bench,scenario,"DrawParticles",NULL,BenchDrawParticles);
+
+        //the lower levels of detail are measured at the zoom that selects them
+        bench->lod = CreateLevelOfDetail();
+        bench->minimap = CreateMinimap(bench->renderer);
+        MinimapRebuild(bench->minimap,bench->snake,&bench->point,bench->atlas);
+        bench->camera.scale = LOD_BLOCKS_SCALE * 0.5f;
+        CameraCenter(&bench->camera,BENCH_TARGET_WIDTH,BENCH_TARGET_HEIGHT);
+        RunOperation(bench,scenario,"DrawDiamonds",NULL,BenchDrawDiamonds);
+        bench->camera.scale = LOD_DIAMONDS_SCALE * 0.5f;
+        CameraCenter(&bench->camera,BENCH_TARGET_WIDTH,BENCH_TARGET_HEIGHT);
+        RunOperation(bench,scenario,"DrawBoardQuad",NULL,BenchDrawBoardQuad);
+        RunOperation(bench,scenario,"MinimapRebuild",NULL,BenchMinimapRebuild);
+        RunOperation(bench,scenario,"MinimapUpdate",BenchResetMinimap,BenchMinimapUpdate);
+        LevelOfDetailFree(bench->lod);
+        MinimapFree(bench->minimap);
+        bench->camera.scale = 1.0f;
+        CameraCenter(&bench->camera,BENCH_TARGET_WIDTH,BENCH_TARGET_HEIGHT);
+
+        StateSetTarget(bench->state,NULL);
+    }
+    ParticlesFree(bench->particles);
+
+    if(bench->renderer != NULL){
+        bench->layer = CreateSnakeLayer(bench->renderer);
+        if(bench->layer != NULL){
+            StateSetTarget(bench->state,bench->target);
+            RunOperation(bench,scenario,"DrawSnakeLayer",BenchResetLayer,BenchDrawSnakeLayer);
+            StateSetTarget(bench->state,NULL);
+            SnakeLayerFree(bench->layer);
+        }
+    }
+
+    SnakeFree(bench->snake);
+    bench->snake = NULL;
+}
+
+int main(int n_args,char **args){
+    unsigned int seed = 1;
+    bool render = true;
+    const char *filter = NULL;
+    const char *save_path = NULL;
+    const char *compare_path = NULL;
+    double alpha = 0.01;
+    double threshold = 0.02;
+
+    Bench bench = {0};
+    bench.min_seconds = 0.25;
+    bench.trials = 1;
+
+    for(int i=1; i<n_args; ++i){
+        if(strcmp(args[i],"--seed") == 0 && i+1 < n_args) seed = strtoul(args[++i],NULL,10);
+        else if(strcmp(args[i],"--filter") == 0 && i+1 < n_args) filter = args[++i];
+        else if(strcmp(args[i],"--no-render") == 0) render = false;
+        else if(strcmp(args[i],"--trials") == 0 && i+1 < n_args) bench.trials = atoi(args[++i]);
+        else if(strcmp(args[i],"--min-time") == 0 && i+1 < n_args) bench.min_seconds = atof(args[++i]);
+        else if(strcmp(args[i],"--save-baseline") == 0 && i+1 < n_args) save_path = args[++i];
+        else if(strcmp(args[i],"--compare") == 0 && i+1 < n_args) compare_path = args[++i];
+        else if(strcmp(args[i],"--alpha") == 0 && i+1 < n_args) alpha = atof(args[++i]);
+        else if(strcmp(args[i],"--threshold") == 0 && i+1 < n_args) threshold = atof(args[++i]);
+    }
+
+    //a rank test needs a handful of samples on each side to reach any significance
+    if((save_path != NULL || compare_path != NULL) && bench.trials < 10) bench.trials = 10;
+    if(bench.trials < 1) bench.trials = 1;
+    if(bench.trials > MAX_TRIALS) bench.trials = MAX_TRIALS;
+
+    Result *baseline = NULL;
+    int baseline_count = 0;
+    if(compare_path != NULL){
+        baseline = malloc(sizeof(Result) * MAX_RESULTS);
+        baseline_count = LoadBaseline(compare_path,baseline);
+        if(baseline_count < 0){
+            fprintf(stderr,"could not open baseline %s\n",compare_path);
+            return 1;
+        }
+    }
+
+    bench.results = malloc(sizeof(Result) * MAX_RESULTS);
+
+    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER);
+
+    SDL_Window *window = NULL;
+
+    if(render){
+        window = SDL_CreateWindow("Snake bench",SDL_WINDOWPOS_UNDEFINED,SDL_WINDOWPOS_UNDEFINED,BENCH_TARGET_WIDTH,BENCH_TARGET_HEIGHT,SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+        bench.renderer = CreateRenderer(window,false);
+        bench.state = CreateRenderState(bench.renderer);
+        bench.atlas = CreateAtlas(bench.state);
+        bench.target = CreateTexture(bench.renderer,BENCH_TARGET_WIDTH,BENCH_TARGET_HEIGHT,PIXEL_FORMAT_RGBA,false,true);
+        bench.queue = CreateRenderQueue();
+    }
+
+    printf("{\n  \"seed\":%u,\n  \"benchmarks\":[",seed);
+
+    for(unsigned int i=0; i<sizeof(scenarios)/sizeof(scenarios[0]); ++i){
+        if(filter != NULL && strstr(scenarios[i].name,filter) == NULL) continue;
+        RunScenario(&bench,&scenarios[i],seed);
+    }
+
+    printf("\n  ]\n}\n");
+
+    int regressions = 0;
+    if(compare_path != NULL){
+        regressions = CompareBaseline(&bench,baseline,baseline_count,alpha,threshold);
+        free(baseline);
+    }
+
+    if(save_path != NULL && !SaveBaseline(&bench,save_path)){
+        fprintf(stderr,"could not write baseline %s\n",save_path);
+    }
+    free(bench.results);
+
+    if(render){
+        TextureFree(bench.target);
+        RenderQueueFree(bench.queue);
+        AtlasFree(bench.atlas);
+        RenderStateFree(bench.state);
+        RendererFree(bench.renderer);
+        SDL_DestroyWindow(window);
+    }
+    SDL_Quit();
+
+    return regressions ? 1 : 0;
+}
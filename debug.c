@@ -0,0 +1,217 @@
+#include "debug.h"
+
+#ifdef DEBUG_DRAW
+
+//everything drawn during a frame is a quad in one untextured vertex buffer submitted by DebugEnd,
+//quads past the capacity of the buffer are dropped
+
+static Camera debug_camera;
+static Vertex debug_vertices[DEBUG_QUADS * 4];
+static unsigned int debug_indices[DEBUG_QUADS * 6];
+static bool debug_indexed;
+static int debug_count;
+static uint64_t debug_dropped;
+
+//3x5 digits and capital letters, a row per 3 bits from the top
+static const uint16_t debug_digits[10] = {
+    0x7B6F,0x2C97,0x73E7,0x73CF,0x5BC9,0x79CF,0x79EF,0x7249,0x7BEF,0x7BCF
+};
+static const uint16_t debug_letters[26] = {
+    0x2BED,0x6BAE,0x3923,0x6B6E,0x79A7,0x79A4,0x396B,0x5BED,0x7497,0x126A,0x5BAD,0x4927,0x5FED,
+    0x6B6D,0x2B6A,0x6BA4,0x2B73,0x6BAD,0x388E,0x7492,0x5B6F,0x5B6A,0x5BFD,0x5AAD,0x5A92,0x72A7
+};
+static const uint16_t debug_minus = 0x01C0;
+
+void DebugBegin(Camera *camera){
+    if(!debug_indexed){
+        for(int i=0; i<DEBUG_QUADS; ++i){
+            unsigned int first = i * 4;
+            unsigned int *index = debug_indices + i * 6;
+            index[0] = first;
+            index[1] = first + 1;
+            index[2] = first + 2;
+            index[3] = first;
+            index[4] = first + 2;
+            index[5] = first + 3;
+        }
+        debug_indexed = true;
+    }
+
+    debug_camera = *camera;
+    debug_count = 0;
+}
+
+static void DebugQuad(Vector2 a,Vector2 b,Vector2 c,Vector2 d,Color color){
+    if(debug_count == DEBUG_QUADS){
+        debug_dropped++;
+        return;
+    }
+
+    Vertex *vertex = debug_vertices + debug_count * 4;
+    vertex[0] = (Vertex){a,color,{0.0f,0.0f}};
+    vertex[1] = (Vertex){b,color,{0.0f,0.0f}};
+    vertex[2] = (Vertex){c,color,{0.0f,0.0f}};
+    vertex[3] = (Vertex){d,color,{0.0f,0.0f}};
+    debug_count++;
+}
+
+//the point of the top faces of the blocks over a board position
+static Vector2 DebugProject(Vector2 position){
+    Vector2 iso = GetIsometricPosition(position.x,position.y);
+    return (Vector2){
+        debug_camera.translate.x + (iso.x + TILE_SIZE) * debug_camera.scale,
+        debug_camera.translate.y + iso.y * debug_camera.scale
+    };
+}
+
+static bool DebugVisible(Vector2 point,float margin){
+    return point.x + margin > 0.0f && point.y + margin > 0.0f && point.x - margin < debug_camera.width && point.y - margin < debug_camera.height;
+}
+
+void DebugLine(Vector2 from,Vector2 to,Color color){
+    Vector2 a = DebugProject(from);
+    Vector2 b = DebugProject(to);
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if(length == 0.0f) return;
+
+    float nx = -dy / length * DEBUG_LINE_WIDTH * 0.5f;
+    float ny = dx / length * DEBUG_LINE_WIDTH * 0.5f;
+    DebugQuad((Vector2){a.x + nx,a.y + ny},(Vector2){b.x + nx,b.y + ny},(Vector2){b.x - nx,b.y - ny},(Vector2){a.x - nx,a.y - ny},color);
+}
+
+void DebugCell(int cell,Color color){
+    float x = (cell % columns) * TILE_SIZE;
+    float y = (cell / columns) * TILE_SIZE;
+    DebugQuad(DebugProject((Vector2){x,y}),DebugProject((Vector2){x + TILE_SIZE,y}),
+        DebugProject((Vector2){x + TILE_SIZE,y + TILE_SIZE}),DebugProject((Vector2){x,y + TILE_SIZE}),color);
+}
+
+//each run of lit pixels in a row is one quad, any other character leaves a space
+static void DebugText(float x,float y,const char *text,Color color){
+    float pixel = DEBUG_LABEL_PIXEL;
+
+    for(int i=0; text[i] != '\0'; ++i, x += 4 * pixel){
+        uint16_t bits;
+        if(text[i] >= '0' && text[i] <= '9') bits = debug_digits[text[i] - '0'];
+        else if(text[i] >= 'A' && text[i] <= 'Z') bits = debug_letters[text[i] - 'A'];
+        else if(text[i] == '-') bits = debug_minus;
+        else continue;
+
+        for(int row=0; row<5; ++row){
+            int line = (bits >> ((4 - row) * 3)) & 0x7;
+            for(int column=0; column<3; ){
+                if(!(line & (4 >> column))){
+                    ++column;
+                    continue;
+                }
+                int start = column;
+                while(column < 3 && (line & (4 >> column))) ++column;
+                float x0 = x + start * pixel;
+                float x1 = x + column * pixel;
+                float y0 = y + row * pixel;
+                float y1 = y0 + pixel;
+                DebugQuad((Vector2){x0,y0},(Vector2){x1,y0},(Vector2){x1,y1},(Vector2){x0,y1},color);
+            }
+        }
+    }
+}
+
+//centered on position
+void DebugLabel(Vector2 position,const char *text,Color color){
+    int length = strlen(text);
+    Vector2 center = DebugProject(position);
+    DebugText(floorf(center.x - (length * 4 - 1) * DEBUG_LABEL_PIXEL * 0.5f),floorf(center.y - 5 * DEBUG_LABEL_PIXEL * 0.5f),text,color);
+}
+
+//the counters of the last frame that reached Flip in the bottom left corner of the screen, zero without GPU_STATS
+void DebugDrawGPUStats(){
+    GPUStats gpu = GetGPUStats();
+    struct{const char *name; uint64_t value;} counters[] = {
+        {"BLITS",gpu.blits},{"GEOMETRY",gpu.geometries},{"POLYGONS",gpu.polygons},{"FLUSHES",gpu.flushes},
+        {"VERTICES",gpu.vertices},{"INDICES",gpu.indices},{"BINDS",gpu.binds},{"TARGETS",gpu.targets}
+    };
+    int count = sizeof(counters) / sizeof(counters[0]);
+    float line = 7 * DEBUG_LABEL_PIXEL;
+    float x = DEBUG_MARGIN;
+    float y = debug_camera.height - DEBUG_MARGIN - count * line;
+
+    char text[32];
+    for(int i=0; i<count; ++i, y += line){
+        snprintf(text,sizeof(text),"%-8s %llu",counters[i].name,(unsigned long long)counters[i].value);
+        float width = strlen(text) * 4 * DEBUG_LABEL_PIXEL;
+        DebugQuad((Vector2){x - DEBUG_LABEL_PIXEL,y - DEBUG_LABEL_PIXEL},(Vector2){x + width,y - DEBUG_LABEL_PIXEL},
+            (Vector2){x + width,y + line - DEBUG_LABEL_PIXEL},(Vector2){x - DEBUG_LABEL_PIXEL,y + line - DEBUG_LABEL_PIXEL},(Color){0,0,0,160});
+        DebugText(x,y,text,(Color){255,255,255,255});
+    }
+}
+
+void DebugEnd(Renderer *renderer){
+    if(debug_count > 0) Geometry(renderer,NULL,debug_vertices,debug_count * 4,debug_indices,debug_count * 6);
+}
+
+uint64_t GetDebugDropped(){
+    return debug_dropped;
+}
+
+static Vector2 GetCellCenter(int cell){
+    return (Vector2){(cell % columns) * TILE_SIZE + TILE_SIZE * 0.5f,(cell / columns) * TILE_SIZE + TILE_SIZE * 0.5f};
+}
+
+//the distance to the food over the wrapping board, the planned path to it,
+//the occupied cells and the number of steps until each of them is free again
+void DebugDrawBoard(Snake *snake,Vector2 *point){
+    int food = GetCell(*point);
+    int food_x = food % columns;
+    int food_y = food / columns;
+    int far = columns / 2 + rows / 2;
+
+    CellRange range = GetVisibleCells(&debug_camera,0.0f);
+    if((int64_t)(range.u1 - range.u0 + 1) * (range.v1 - range.v0 + 1) <= DEBUG_QUADS / 2){
+        int x0,x1;
+        for(int v=range.v0; v<=range.v1; ++v){
+            GetDiagonalCells(&range,v,&x0,&x1);
+            for(int x=x0; x<=x1; ++x){
+                int y = v - x;
+                int dx = abs(x - food_x);
+                int dy = abs(y - food_y);
+                int distance = ((dx < columns - dx) ? dx : columns - dx) + ((dy < rows - dy) ? dy : rows - dy);
+                uint8_t t = (uint8_t)(255 * distance / far);
+                DebugCell(y * columns + x,(Color){255 - t,0,t,60});
+            }
+        }
+    }
+
+    int head = GetCell(snake->head->current_position);
+    if(snake->solver != NULL){
+        Solver *solver = snake->solver;
+        int steps = CycleDistance(solver,head,food);
+        int cell = head;
+        for(int i=0; i<steps && debug_count < DEBUG_QUADS; ++i){
+            int next = solver->cells[(solver->cycle[cell] + 1) % solver->count];
+            //the cycle wraps around the edges of the board, those steps are not drawn across it
+            if(abs(next % columns - cell % columns) + abs(next / columns - cell / columns) == 1){
+                DebugLine(GetCellCenter(cell),GetCellCenter(next),(Color){255,255,255,255});
+            }
+            cell = next;
+        }
+    }
+    else{
+        DebugLine(GetCellCenter(head),GetCellCenter(food),(Color){255,255,255,255});
+    }
+
+    char label[16];
+    int index = 0;
+    for(Piece *piece = snake->head; piece != NULL; piece = piece->next, ++index){
+        int cell = GetCell(piece->current_position);
+        Vector2 center = GetCellCenter(cell);
+        if(!DebugVisible(DebugProject(center),TILE_SIZE * debug_camera.scale)) continue;
+
+        DebugCell(cell,(Color){255,255,255,90});
+        snprintf(label,sizeof(label),"%d",snake->length - index);
+        DebugLabel(center,label,(Color){0,0,0,255});
+    }
+}
+
+#endif
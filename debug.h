@@ -0,0 +1,49 @@
+#ifndef DEBUG_H_
+#define DEBUG_H_
+
+#include "snake.h"
+
+//building with -DDEBUG_DRAW turns on the debug overlay, without it every call below compiles to nothing
+//positions are board pixels drawn on the plane of the top of the blocks, lines and labels keep their screen size
+//labels take digits, capital letters and minus signs from a built-in 3x5 font
+
+#define DEBUG_QUADS 65536
+#define DEBUG_LINE_WIDTH 2.0f
+#define DEBUG_LABEL_PIXEL 2.0f
+#define DEBUG_MARGIN 10.0f
+
+#ifdef DEBUG_DRAW
+
+#define DebugDrawEnabled() true
+
+void DebugBegin(Camera *camera);
+
+void DebugLine(Vector2 from,Vector2 to,Color color);
+
+void DebugCell(int cell,Color color);
+
+void DebugLabel(Vector2 position,const char *text,Color color);
+
+void DebugEnd(Renderer *renderer);
+
+void DebugDrawBoard(Snake *snake,Vector2 *point);
+
+void DebugDrawGPUStats();
+
+uint64_t GetDebugDropped();
+
+#else
+
+#define DebugDrawEnabled() false
+#define DebugBegin(camera) ((void)0)
+#define DebugLine(from,to,color) ((void)0)
+#define DebugCell(cell,color) ((void)0)
+#define DebugLabel(position,text,color) ((void)0)
+#define DebugEnd(renderer) ((void)0)
+#define DebugDrawBoard(snake,point) ((void)0)
+#define DebugDrawGPUStats() ((void)0)
+#define GetDebugDropped() ((uint64_t)0)
+
+#endif
+
+#endif
@@ -0,0 +1,230 @@
+#include "frame.h"
+
+void PacerInit(FramePacer *pacer,double fps,PacingMode mode){
+    pacer->mode = mode;
+    pacer->period = (fps > 0.0) ? 1.0 / fps : 0.0;
+    pacer->spin_margin = MAX_SPIN_MARGIN;
+
+    pacer->frequency = SDL_GetPerformanceFrequency();
+    pacer->last_frame = SDL_GetPerformanceCounter();
+    pacer->stats_start = pacer->last_frame;
+    pacer->deadline = pacer->last_frame + (uint64_t)(pacer->period * pacer->frequency);
+
+    pacer->frames = 0;
+    pacer->sum = 0.0;
+    pacer->sum_squares = 0.0;
+    pacer->max_error = 0.0;
+    pacer->waited = 0.0;
+}
+
+double PacerSeconds(FramePacer *pacer,uint64_t start,uint64_t end){
+    return (double)((int64_t)(end - start)) / pacer->frequency;
+}
+
+void PacerSleep(FramePacer *pacer,double margin){
+    uint64_t now = SDL_GetPerformanceCounter();
+    double remaining = PacerSeconds(pacer,now,pacer->deadline) - margin;
+    if(remaining < 0.001) return;
+
+    SDL_Delay((uint32_t)(remaining * 1000.0));
+
+    double slept = PacerSeconds(pacer,now,SDL_GetPerformanceCounter());
+    pacer->waited += slept;
+
+    //the margin follows the worst oversleep seen recently and slowly decays back
+    double oversleep = slept - (uint32_t)(remaining * 1000.0) / 1000.0;
+    if(oversleep > pacer->spin_margin) pacer->spin_margin = fmin(oversleep,MAX_SPIN_MARGIN);
+    else pacer->spin_margin = fmax(pacer->spin_margin * 0.99,MIN_SPIN_MARGIN);
+}
+
+void PacerWait(FramePacer *pacer){
+
+    if(pacer->period > 0.0){
+        if(pacer->mode == PACING_SLEEP){
+            PacerSleep(pacer,0.0);
+        }
+        else if(pacer->mode == PACING_HYBRID){
+            PacerSleep(pacer,pacer->spin_margin);
+        }
+
+        while(pacer->mode != PACING_SLEEP && (int64_t)(pacer->deadline - SDL_GetPerformanceCounter()) > 0){}
+    }
+
+    uint64_t now = SDL_GetPerformanceCounter();
+    uint64_t period = (uint64_t)(pacer->period * pacer->frequency);
+
+    //after a long stall the schedule restarts instead of rushing frames to catch up
+    pacer->deadline += period;
+    if((int64_t)(now - pacer->deadline) > 0) pacer->deadline = now + period;
+
+    double frame_time = PacerSeconds(pacer,pacer->last_frame,now);
+    double error = fabs(frame_time - pacer->period);
+    pacer->last_frame = now;
+
+    pacer->frames++;
+    pacer->sum += frame_time;
+    pacer->sum_squares += frame_time * frame_time;
+    if(pacer->period > 0.0 && error > pacer->max_error) pacer->max_error = error;
+}
+
+//blocks until an event is queued or the timeout expires, the event stays in the queue
+bool PacerIdle(FramePacer *pacer,int timeout){
+    uint64_t start = SDL_GetPerformanceCounter();
+    bool event = SDL_WaitEventTimeout(NULL,timeout);
+    pacer->waited += PacerSeconds(pacer,start,SDL_GetPerformanceCounter());
+    return event;
+}
+
+void PacerResume(FramePacer *pacer){
+    pacer->last_frame = SDL_GetPerformanceCounter();
+    pacer->deadline = pacer->last_frame + (uint64_t)(pacer->period * pacer->frequency);
+}
+
+bool PacerStats(FramePacer *pacer,FrameStats *stats){
+    uint64_t now = SDL_GetPerformanceCounter();
+    double elapsed = PacerSeconds(pacer,pacer->stats_start,now);
+    if(elapsed < 1.0) return false;
+
+    double average = pacer->frames ? pacer->sum / pacer->frames : 0.0;
+
+    stats->frames = pacer->frames;
+    stats->fps = pacer->frames / elapsed;
+    stats->average = average;
+    stats->jitter = pacer->frames ? sqrt(fmax(pacer->sum_squares / pacer->frames - average * average,0.0)) : 0.0;
+    stats->max_error = pacer->max_error;
+    stats->cpu = fmax(1.0 - pacer->waited / elapsed,0.0);
+
+    pacer->stats_start = now;
+    pacer->frames = 0;
+    pacer->sum = 0.0;
+    pacer->sum_squares = 0.0;
+    pacer->max_error = 0.0;
+    pacer->waited = 0.0;
+
+    return true;
+}
+
+void FrameCacheInit(FrameCache *cache){
+    cache->texture = NULL;
+    cache->width = 0;
+    cache->height = 0;
+    cache->region = (Rect){0.0f,0.0f,0.0f,0.0f};
+    cache->valid = false;
+    cache->keep = false;
+    cache->offscreen = false;
+
+    cache->state = UINT64_MAX;
+    cache->view = UINT64_MAX;
+
+    cache->rendered = 0;
+    cache->presented = 0;
+    cache->skipped = 0;
+}
+
+void FrameCacheFree(FrameCache *cache){
+    if(cache->texture != NULL) TextureFree(cache->texture);
+    cache->texture = NULL;
+    cache->valid = false;
+}
+
+//decides what a frame with the given state and view versions needs
+//an unchanged frame is left on screen, or presented from the cache when the window asked for a redraw
+FrameAction FrameCacheCheck(FrameCache *cache,uint64_t state,uint64_t view,bool redraw){
+    if(state == cache->state && view == cache->view){
+        if(!redraw){
+            cache->skipped++;
+            return FRAME_SKIP;
+        }
+        if(cache->valid){
+            cache->presented++;
+            return FRAME_PRESENT;
+        }
+    }
+    cache->rendered++;
+    return FRAME_RENDER;
+}
+
+//switches to the target the frame is drawn to, the screen or the cache texture
+//frames below full resolution or kept for later are drawn to the top left region of the cache texture
+void FrameCacheBegin(FrameCache *cache,RenderState *state,int width,int height,float resolution,bool keep){
+    cache->keep = keep;
+    cache->valid = false;
+    cache->offscreen = keep || resolution < 1.0f;
+    if(!cache->offscreen) return;
+
+    if(cache->texture == NULL || cache->width != width || cache->height != height){
+        if(cache->texture != NULL){
+            StateForget(state,cache->texture);
+            TextureFree(cache->texture);
+        }
+        cache->texture = CreateTexture(state->renderer,width,height,PIXEL_FORMAT_RGBA,false,true);
+        cache->width = width;
+        cache->height = height;
+    }
+    StateSetTextureFilter(state,cache->texture,FILTER_LINEAR,FILTER_LINEAR);
+
+    //the texture keeps the window size, a smaller resolution only shrinks the region that is filled
+    cache->region = (Rect){0.0f,0.0f,ceilf(width * resolution),ceilf(height * resolution)};
+
+    StateSetTarget(state,cache->texture);
+    StateSetClip(state,cache->texture,&cache->region);
+}
+
+void FrameCacheEnd(FrameCache *cache,RenderState *render_state,uint64_t state,uint64_t view){
+    cache->state = state;
+    cache->view = view;
+
+    if(cache->offscreen){
+        StateSetTarget(render_state,NULL);
+        FrameCachePresent(cache,render_state->renderer);
+        cache->valid = cache->keep;
+    }
+}
+
+//the region is stretched over the whole window
+void FrameCachePresent(FrameCache *cache,Renderer *renderer){
+    Blit(renderer,cache->texture,&cache->region,&(Rect){0.0f,0.0f,cache->width,cache->height});
+}
+
+void ScalerInit(ResolutionScaler *scaler,double budget,float min_scale,float max_scale){
+    scaler->min_scale = fminf(min_scale,max_scale);
+    scaler->max_scale = max_scale;
+    scaler->scale = max_scale;
+
+    scaler->budget = budget * RESOLUTION_HEADROOM;
+    scaler->average = 0.0;
+    scaler->frames = 0;
+
+    scaler->frequency = SDL_GetPerformanceFrequency();
+    scaler->start = 0;
+    scaler->changes = 0;
+}
+
+void ScalerBegin(ResolutionScaler *scaler){
+    scaler->start = SDL_GetPerformanceCounter();
+}
+
+//the time from the start of the frame to the end of Flip is compared against the budget
+//fill cost goes with the area, so an expensive frame drops the scale by the square root of the overshoot
+//and a cheap one raises it a step at a time, every change waits a few frames for the average to follow
+void ScalerEnd(ResolutionScaler *scaler){
+    double time = (double)(SDL_GetPerformanceCounter() - scaler->start) / scaler->frequency;
+    scaler->average = (scaler->frames == 0) ? time : scaler->average * 0.9 + time * 0.1;
+    if(++scaler->frames < RESOLUTION_SETTLE) return;
+
+    float scale = scaler->scale;
+    if(scaler->average > scaler->budget){
+        scale = floorf(scale * sqrt(scaler->budget / scaler->average) / RESOLUTION_STEP) * RESOLUTION_STEP;
+        scale = fminf(scale,scaler->scale - RESOLUTION_STEP);
+    }
+    else if(scaler->average < scaler->budget * 0.7){
+        scale += RESOLUTION_STEP;
+    }
+    scale = fmaxf(fminf(scale,scaler->max_scale),scaler->min_scale);
+
+    if(scale != scaler->scale){
+        scaler->scale = scale;
+        scaler->frames = 0;
+        scaler->changes++;
+    }
+}
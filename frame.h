@@ -0,0 +1,117 @@
+#ifndef FRAME_H_
+#define FRAME_H_
+
+#include "gpu_stats.h"
+
+#include "state.h"
+
+#define MIN_SPIN_MARGIN 0.0005
+#define MAX_SPIN_MARGIN 0.004
+#define IDLE_TIMEOUT 250
+
+#define MIN_RESOLUTION 0.5f
+#define RESOLUTION_STEP 0.0625f
+#define RESOLUTION_HEADROOM 0.9
+#define RESOLUTION_SETTLE 8
+
+typedef enum _PacingMode{
+    PACING_SLEEP,
+    PACING_SPIN,
+    PACING_HYBRID,
+}PacingMode;
+
+typedef enum _FrameAction{
+    FRAME_RENDER,
+    FRAME_PRESENT,
+    FRAME_SKIP,
+}FrameAction;
+
+typedef struct _FrameStats{
+    int frames;
+    double fps;
+    double average;
+    double jitter;
+    double max_error;
+    double cpu;
+}FrameStats;
+
+typedef struct _FramePacer{
+    PacingMode mode;
+    double period;
+    double spin_margin;
+
+    uint64_t frequency;
+    uint64_t deadline;
+    uint64_t last_frame;
+    uint64_t stats_start;
+
+    int frames;
+    double sum;
+    double sum_squares;
+    double max_error;
+    double waited;
+}FramePacer;
+
+typedef struct _FrameCache{
+    Texture *texture;
+    int width;
+    int height;
+    Rect region;
+    bool valid;
+    bool keep;
+    bool offscreen;
+
+    uint64_t state;
+    uint64_t view;
+
+    uint64_t rendered;
+    uint64_t presented;
+    uint64_t skipped;
+}FrameCache;
+
+typedef struct _ResolutionScaler{
+    float scale;
+    float min_scale;
+    float max_scale;
+
+    double budget;
+    double average;
+    int frames;
+
+    uint64_t frequency;
+    uint64_t start;
+    uint64_t changes;
+}ResolutionScaler;
+
+
+void PacerInit(FramePacer *pacer,double fps,PacingMode mode);
+
+void PacerWait(FramePacer *pacer);
+
+bool PacerIdle(FramePacer *pacer,int timeout);
+
+void PacerResume(FramePacer *pacer);
+
+bool PacerStats(FramePacer *pacer,FrameStats *stats);
+
+
+void FrameCacheInit(FrameCache *cache);
+
+void FrameCacheFree(FrameCache *cache);
+
+FrameAction FrameCacheCheck(FrameCache *cache,uint64_t state,uint64_t view,bool redraw);
+
+void FrameCacheBegin(FrameCache *cache,RenderState *state,int width,int height,float resolution,bool keep);
+
+void FrameCacheEnd(FrameCache *cache,RenderState *render_state,uint64_t state,uint64_t view);
+
+void FrameCachePresent(FrameCache *cache,Renderer *renderer);
+
+
+void ScalerInit(ResolutionScaler *scaler,double budget,float min_scale,float max_scale);
+
+void ScalerBegin(ResolutionScaler *scaler);
+
+void ScalerEnd(ResolutionScaler *scaler);
+
+#endif
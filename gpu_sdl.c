@@ -0,0 +1,742 @@
+#include <GPU.h>
+
+#define CIRCLE_SEGMENTS 48
+#define MAX_SHAPE_POINTS 64
+
+struct _Texture{
+    Renderer *renderer;
+    SDL_Texture *texture;
+    int width;
+    int height;
+    PixelFormat format;
+    bool mipmap;
+    bool framebuffer;
+
+    Filter min_filter;
+    Filter mag_filter;
+    Wrap wrap_x;
+    Wrap wrap_y;
+
+    BlendMode blend_mode;
+    bool blending;
+    bool clipping;
+    Rect clip;
+    bool has_viewport;
+    Rect viewport;
+
+    //framebuffer textures cannot be locked by SDL, they are read back into this copy
+    void *lock_pixels;
+    SDL_Rect lock_rect;
+};
+
+struct _Renderer{
+    SDL_Window *window;
+    SDL_Renderer *renderer;
+    Texture screen;
+    Texture *target;
+    bool batching;
+
+    //pending geometry, all of it uses batch_texture and the state of the current target
+    Texture *batch_texture;
+    SDL_Vertex *vertices;
+    int *indices;
+    int vertices_count;
+    int indices_count;
+    int vertices_capacity;
+    int indices_capacity;
+};
+
+
+static Texture* GetTarget(Renderer *renderer,Texture *target){
+    return target != NULL ? target : &renderer->screen;
+}
+
+static SDL_BlendFactor GetBlendFactor(uint32_t function){
+    switch(function){
+        case FUNC_ZERO:                return SDL_BLENDFACTOR_ZERO;
+        case FUNC_SRC_COLOR:           return SDL_BLENDFACTOR_SRC_COLOR;
+        case FUNC_ONE_MINUS_SRC_COLOR: return SDL_BLENDFACTOR_ONE_MINUS_SRC_COLOR;
+        case FUNC_DST_COLOR:           return SDL_BLENDFACTOR_DST_COLOR;
+        case FUNC_ONE_MINUS_DST_COLOR: return SDL_BLENDFACTOR_ONE_MINUS_DST_COLOR;
+        case FUNC_SRC_ALPHA:           return SDL_BLENDFACTOR_SRC_ALPHA;
+        case FUNC_ONE_MINUS_SRC_ALPHA: return SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        case FUNC_DST_ALPHA:           return SDL_BLENDFACTOR_DST_ALPHA;
+        case FUNC_ONE_MINUS_DST_ALPHA: return SDL_BLENDFACTOR_ONE_MINUS_DST_ALPHA;
+    }
+    return SDL_BLENDFACTOR_ONE;
+}
+
+static SDL_BlendOperation GetBlendOperation(uint32_t equation){
+    switch(equation){
+        case EQ_SUBTRACT:         return SDL_BLENDOPERATION_SUBTRACT;
+        case EQ_REVERSE_SUBTRACT: return SDL_BLENDOPERATION_REV_SUBTRACT;
+        case EQ_MIN:              return SDL_BLENDOPERATION_MINIMUM;
+        case EQ_MAX:              return SDL_BLENDOPERATION_MAXIMUM;
+    }
+    return SDL_BLENDOPERATION_ADD;
+}
+
+static bool BlendModeEquals(BlendMode a,BlendModePreset preset){
+    BlendMode b = GetBlendModeByPreset(preset);
+    return memcmp(&a,&b,sizeof(BlendMode)) == 0;
+}
+
+//the software renderer only knows the builtin modes, so those are preferred over composed ones
+static SDL_BlendMode GetSDLBlendMode(Texture *target){
+    if(!target->blending || BlendModeEquals(target->blend_mode,BLEND_SET)) return SDL_BLENDMODE_NONE;
+    if(BlendModeEquals(target->blend_mode,BLEND_NORMAL)) return SDL_BLENDMODE_BLEND;
+    if(BlendModeEquals(target->blend_mode,BLEND_ADD)) return SDL_BLENDMODE_ADD;
+    if(BlendModeEquals(target->blend_mode,BLEND_MULTIPLY)) return SDL_BLENDMODE_MUL;
+
+    BlendMode *mode = &target->blend_mode;
+    return SDL_ComposeCustomBlendMode(
+        GetBlendFactor(mode->srcRGB),GetBlendFactor(mode->dstRGB),GetBlendOperation(mode->modeRGB),
+        GetBlendFactor(mode->srcAlpha),GetBlendFactor(mode->dstAlpha),GetBlendOperation(mode->modeAlpha)
+    );
+}
+
+static void ApplyClip(Renderer *renderer,Texture *target){
+    if(!target->clipping && !target->has_viewport){
+        SDL_RenderSetClipRect(renderer->renderer,NULL);
+        return;
+    }
+
+    float x0 = 0.0f, y0 = 0.0f, x1 = target->width, y1 = target->height;
+    if(target->has_viewport){
+        x0 = fmaxf(x0,target->viewport.x);
+        y0 = fmaxf(y0,target->viewport.y);
+        x1 = fminf(x1,target->viewport.x + target->viewport.w);
+        y1 = fminf(y1,target->viewport.y + target->viewport.h);
+    }
+    if(target->clipping){
+        x0 = fmaxf(x0,target->clip.x);
+        y0 = fmaxf(y0,target->clip.y);
+        x1 = fminf(x1,target->clip.x + target->clip.w);
+        y1 = fminf(y1,target->clip.y + target->clip.h);
+    }
+
+    SDL_Rect rect = {(int)x0,(int)y0,(int)fmaxf(x1 - x0,0.0f),(int)fmaxf(y1 - y0,0.0f)};
+    SDL_RenderSetClipRect(renderer->renderer,&rect);
+}
+
+static inline SDL_FPoint MapPoint(Texture *target,Vector2 point){
+    if(!target->has_viewport) return (SDL_FPoint){point.x,point.y};
+    return (SDL_FPoint){
+        target->viewport.x + point.x * target->viewport.w / target->width,
+        target->viewport.y + point.y * target->viewport.h / target->height
+    };
+}
+
+static void ApplyState(Renderer *renderer,Texture *texture){
+    Texture *target = renderer->target;
+    SDL_BlendMode mode = GetSDLBlendMode(target);
+
+    if(texture != NULL) SDL_SetTextureBlendMode(texture->texture,mode);
+    SDL_SetRenderDrawBlendMode(renderer->renderer,mode);
+    ApplyClip(renderer,target);
+}
+
+void FlushBlitBuffer(Renderer *renderer){
+    if(renderer->indices_count == 0) return;
+
+    ApplyState(renderer,renderer->batch_texture);
+    SDL_RenderGeometry(renderer->renderer,renderer->batch_texture ? renderer->batch_texture->texture : NULL,
+        renderer->vertices,renderer->vertices_count,renderer->indices,renderer->indices_count);
+
+    renderer->vertices_count = 0;
+    renderer->indices_count = 0;
+}
+
+//makes room for the geometry in the batch, a different texture ends the current batch
+//there is one pending batch instead of one per texture: the game draws back to front with the atlas,
+//the layer, the hud and untextured quads overlapping each other, and per texture arrays flushed
+//later would draw them out of order. runs of the same texture, which is most of a frame, still merge
+static SDL_Vertex* BatchReserve(Renderer *renderer,Texture *texture,int vertices_count,int indices_count,int **indices,int *base){
+    if(texture != renderer->batch_texture || !renderer->batching){
+        FlushBlitBuffer(renderer);
+        renderer->batch_texture = texture;
+    }
+
+    if(renderer->vertices_count + vertices_count > renderer->vertices_capacity){
+        renderer->vertices_capacity = (renderer->vertices_count + vertices_count) * 2;
+        renderer->vertices = realloc(renderer->vertices,sizeof(SDL_Vertex) * renderer->vertices_capacity);
+    }
+    if(renderer->indices_count + indices_count > renderer->indices_capacity){
+        renderer->indices_capacity = (renderer->indices_count + indices_count) * 2;
+        renderer->indices = realloc(renderer->indices,sizeof(int) * renderer->indices_capacity);
+    }
+
+    *base = renderer->vertices_count;
+    *indices = renderer->indices + renderer->indices_count;
+    SDL_Vertex *vertices = renderer->vertices + renderer->vertices_count;
+
+    renderer->vertices_count += vertices_count;
+    renderer->indices_count += indices_count;
+
+    return vertices;
+}
+
+static void BatchQuad(Renderer *renderer,Texture *texture,Vector2 *corners,Vector2 *texcoords,Color color){
+    int *indices;
+    int base;
+    SDL_Vertex *vertices = BatchReserve(renderer,texture,4,6,&indices,&base);
+
+    for(int i=0; i<4; ++i){
+        vertices[i].position = MapPoint(renderer->target,corners[i]);
+        vertices[i].color = (SDL_Color){color.r,color.g,color.b,color.a};
+        vertices[i].tex_coord = texcoords != NULL ? (SDL_FPoint){texcoords[i].x,texcoords[i].y} : (SDL_FPoint){0.0f,0.0f};
+    }
+
+    indices[0] = base;
+    indices[1] = base + 1;
+    indices[2] = base + 2;
+    indices[3] = base;
+    indices[4] = base + 2;
+    indices[5] = base + 3;
+}
+
+
+BlendMode GetBlendModeByPreset(BlendModePreset preset){
+    switch(preset){
+        case BLEND_PREMULTIPLIED_ALPHA: return (BlendMode){FUNC_ONE,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ONE,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        case BLEND_MULTIPLY:            return (BlendMode){FUNC_DST_COLOR,FUNC_ZERO,FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        case BLEND_ADD:                 return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE,FUNC_SRC_ALPHA,FUNC_ONE,EQ_ADD,EQ_ADD};
+        case BLEND_SUBTRACT:            return (BlendMode){FUNC_ONE,FUNC_ONE,FUNC_ONE,FUNC_ONE,EQ_SUBTRACT,EQ_SUBTRACT};
+        case BLEND_MOD_ALPHA:           return (BlendMode){FUNC_ZERO,FUNC_ONE,FUNC_ZERO,FUNC_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        case BLEND_SET_ALPHA:           return (BlendMode){FUNC_ZERO,FUNC_ONE,FUNC_ONE,FUNC_ZERO,EQ_ADD,EQ_ADD};
+        case BLEND_SET:                 return (BlendMode){FUNC_ONE,FUNC_ZERO,FUNC_ONE,FUNC_ZERO,EQ_ADD,EQ_ADD};
+        case BLEND_NORMAL_KEEP_ALPHA:   return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ZERO,FUNC_ONE,EQ_ADD,EQ_ADD};
+        case BLEND_NORMAL_ADD_ALPHA:    return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ONE,FUNC_ONE,EQ_ADD,EQ_ADD};
+        case BLEND_NORMAL_FACTOR_ALPHA: return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ONE,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        default:                        return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+    }
+}
+
+//state changes end the batch that was built under the previous state
+
+void SetBlendFunction(Renderer *renderer,Texture *target,BlendFunction srcRGB,BlendFunction dstRGB,BlendFunction srcAlpha,BlendFunction dstAlpha){
+    FlushBlitBuffer(renderer);
+    target = GetTarget(renderer,target);
+    target->blend_mode.srcRGB = srcRGB;
+    target->blend_mode.dstRGB = dstRGB;
+    target->blend_mode.srcAlpha = srcAlpha;
+    target->blend_mode.dstAlpha = dstAlpha;
+}
+
+void SetBlendEquation(Renderer *renderer,Texture *target,BlendEquation modeRGB,BlendEquation modeAlpha){
+    FlushBlitBuffer(renderer);
+    target = GetTarget(renderer,target);
+    target->blend_mode.modeRGB = modeRGB;
+    target->blend_mode.modeAlpha = modeAlpha;
+}
+
+void SetBlendModeByPreset(Renderer *renderer,Texture *target,BlendModePreset preset){
+    FlushBlitBuffer(renderer);
+    GetTarget(renderer,target)->blend_mode = GetBlendModeByPreset(preset);
+}
+
+void SetBlendMode(Renderer *renderer,Texture *target,BlendMode blend_mode){
+    FlushBlitBuffer(renderer);
+    GetTarget(renderer,target)->blend_mode = blend_mode;
+}
+
+void SetBlending(Renderer *renderer,Texture *target,bool blending){
+    FlushBlitBuffer(renderer);
+    GetTarget(renderer,target)->blending = blending;
+}
+
+
+void SetClip(Renderer *renderer,Texture *target,Rect *rect){
+    FlushBlitBuffer(renderer);
+    target = GetTarget(renderer,target);
+    target->clipping = true;
+    target->clip = *rect;
+}
+
+void UnSetClip(Renderer *renderer,Texture *target){
+    FlushBlitBuffer(renderer);
+    GetTarget(renderer,target)->clipping = false;
+}
+
+
+static void InitTextureState(Texture *texture,int width,int height,PixelFormat format,bool mipmap,bool framebuffer){
+    texture->width = width;
+    texture->height = height;
+    texture->format = format;
+    texture->mipmap = mipmap;
+    texture->framebuffer = framebuffer;
+    texture->min_filter = FILTER_LINEAR;
+    texture->mag_filter = FILTER_LINEAR;
+    texture->wrap_x = WRAP_CLAMP_TO_EDGE;
+    texture->wrap_y = WRAP_CLAMP_TO_EDGE;
+    texture->blend_mode = GetBlendModeByPreset(BLEND_NORMAL);
+    texture->blending = true;
+    texture->clipping = false;
+    texture->clip = (Rect){0.0f,0.0f,width,height};
+    texture->has_viewport = false;
+    texture->viewport = (Rect){0.0f,0.0f,width,height};
+    texture->lock_pixels = NULL;
+}
+
+Texture* CreateTexture(Renderer *renderer,int width,int height,PixelFormat format,bool mipmap,bool framebuffer){
+    int access = framebuffer ? SDL_TEXTUREACCESS_TARGET : SDL_TEXTUREACCESS_STREAMING;
+    SDL_Texture *sdl_texture = SDL_CreateTexture(renderer->renderer,SDL_PIXELFORMAT_RGBA32,access,width,height);
+    if(sdl_texture == NULL) return NULL;
+
+    Texture *texture = malloc(sizeof(Texture));
+    texture->renderer = renderer;
+    texture->texture = sdl_texture;
+    InitTextureState(texture,width,height,format,mipmap,framebuffer);
+    SDL_SetTextureBlendMode(sdl_texture,SDL_BLENDMODE_BLEND);
+
+    //new textures start transparent like in GL
+    if(framebuffer){
+        FlushBlitBuffer(renderer);
+        SDL_SetRenderTarget(renderer->renderer,sdl_texture);
+        SDL_SetRenderDrawColor(renderer->renderer,0,0,0,0);
+        SDL_RenderClear(renderer->renderer);
+        SDL_SetRenderTarget(renderer->renderer,renderer->target != &renderer->screen ? renderer->target->texture : NULL);
+    }
+    else{
+        void *pixels;
+        int pitch;
+        if(SDL_LockTexture(sdl_texture,NULL,&pixels,&pitch) == 0){
+            memset(pixels,0,(size_t)pitch * height);
+            SDL_UnlockTexture(sdl_texture);
+        }
+    }
+
+    return texture;
+}
+
+Texture* LoadTexture(Renderer *renderer,const char *fileName,bool mipmap,bool framebuffer){
+    SDL_Surface *surface = SDL_LoadBMP(fileName);
+    if(surface == NULL) return NULL;
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface,SDL_PIXELFORMAT_RGBA32,0);
+    SDL_FreeSurface(surface);
+    if(converted == NULL) return NULL;
+
+    Texture *texture = CreateTexture(renderer,converted->w,converted->h,PIXEL_FORMAT_RGBA,mipmap,framebuffer);
+    if(texture != NULL) SDL_UpdateTexture(texture->texture,NULL,converted->pixels,converted->pitch);
+    SDL_FreeSurface(converted);
+
+    return texture;
+}
+
+void TextureFree(Texture *texture){
+    if(texture == NULL) return;
+    //the pending batch still samples the texture
+    if(texture->renderer->batch_texture == texture){
+        FlushBlitBuffer(texture->renderer);
+        texture->renderer->batch_texture = NULL;
+    }
+    SDL_DestroyTexture(texture->texture);
+    free(texture->lock_pixels);
+    free(texture);
+}
+
+void SetTextureFilter(Texture *texture,Filter min_filter,Filter mag_filter){
+    texture->min_filter = min_filter;
+    texture->mag_filter = mag_filter;
+    SDL_SetTextureScaleMode(texture->texture,mag_filter == FILTER_NEAREST ? SDL_ScaleModeNearest : SDL_ScaleModeLinear);
+}
+
+void SetTextureWrap(Texture *texture,Wrap wrap_x,Wrap wrap_y){
+    texture->wrap_x = wrap_x;
+    texture->wrap_y = wrap_y;
+}
+
+void GenerateFrameBuffer(Renderer *renderer,Texture *texture){
+}
+
+void GenearateMipmap(Renderer *renderer,Texture *texture){
+    texture->mipmap = true;
+}
+
+void LockTexture(Texture *texture,Rect *rect,void **pixels,int *pitch){
+    SDL_Rect area = rect != NULL ? (SDL_Rect){(int)rect->x,(int)rect->y,(int)rect->w,(int)rect->h} : (SDL_Rect){0,0,texture->width,texture->height};
+    texture->lock_rect = area;
+
+    if(!texture->framebuffer){
+        SDL_LockTexture(texture->texture,&area,pixels,pitch);
+        return;
+    }
+
+    Renderer *renderer = texture->renderer;
+    texture->lock_pixels = realloc(texture->lock_pixels,(size_t)area.w * area.h * sizeof(uint32_t));
+    *pixels = texture->lock_pixels;
+    *pitch = area.w * sizeof(uint32_t);
+
+    FlushBlitBuffer(renderer);
+    SDL_SetRenderTarget(renderer->renderer,texture->texture);
+    SDL_RenderReadPixels(renderer->renderer,&area,SDL_PIXELFORMAT_RGBA32,*pixels,*pitch);
+    SDL_SetRenderTarget(renderer->renderer,renderer->target != &renderer->screen ? renderer->target->texture : NULL);
+}
+
+void UnlockTexture(Texture *texture){
+    if(!texture->framebuffer){
+        SDL_UnlockTexture(texture->texture);
+        return;
+    }
+    SDL_UpdateTexture(texture->texture,&texture->lock_rect,texture->lock_pixels,texture->lock_rect.w * sizeof(uint32_t));
+}
+
+void TextureSize(Texture *texture,int *width,int *height){
+    if(width != NULL) *width = texture->width;
+    if(height != NULL) *height = texture->height;
+}
+
+void TextureFormat(Texture *texture,PixelFormat *format){
+    *format = texture->format;
+}
+
+bool TextureHasFrameBuffer(Texture *texture){
+    return texture->framebuffer;
+}
+
+bool TextureHasMipmap(Texture *texture){
+    return texture->mipmap;
+}
+
+void TextureWrap(Texture *texture,Wrap *wrap_x,Wrap *wrap_y){
+    *wrap_x = texture->wrap_x;
+    *wrap_y = texture->wrap_y;
+}
+
+void TextureFilter(Texture *texture,Filter *min_filter,Filter *mag_filter){
+    *min_filter = texture->min_filter;
+    *mag_filter = texture->mag_filter;
+}
+
+
+Renderer* CreateRenderer(SDL_Window *window,bool vsync){
+    Uint32 flags = SDL_RENDERER_TARGETTEXTURE | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+    SDL_Renderer *sdl_renderer = SDL_CreateRenderer(window,-1,flags);
+    if(sdl_renderer == NULL) return NULL;
+
+    Renderer *renderer = malloc(sizeof(Renderer));
+    renderer->window = window;
+    renderer->renderer = sdl_renderer;
+    renderer->target = &renderer->screen;
+
+    //GPU_SDL_BATCH=0 submits every draw on its own, to compare against the batched path
+    const char *batching = SDL_getenv("GPU_SDL_BATCH");
+    renderer->batching = batching == NULL || strcmp(batching,"0") != 0;
+
+    renderer->batch_texture = NULL;
+    renderer->vertices = NULL;
+    renderer->indices = NULL;
+    renderer->vertices_count = 0;
+    renderer->indices_count = 0;
+    renderer->vertices_capacity = 0;
+    renderer->indices_capacity = 0;
+
+    int width,height;
+    SDL_GetRendererOutputSize(sdl_renderer,&width,&height);
+    renderer->screen.renderer = renderer;
+    renderer->screen.texture = NULL;
+    InitTextureState(&renderer->screen,width,height,PIXEL_FORMAT_RGBA,false,true);
+
+    return renderer;
+}
+
+void RendererFree(Renderer *renderer){
+    SDL_DestroyRenderer(renderer->renderer);
+    free(renderer->vertices);
+    free(renderer->indices);
+    free(renderer);
+}
+
+void RendererSetTarget(Renderer *renderer,Texture *target){
+    FlushBlitBuffer(renderer);
+    renderer->target = GetTarget(renderer,target);
+    SDL_SetRenderTarget(renderer->renderer,target != NULL ? target->texture : NULL);
+}
+
+void RendererSetVsync(Renderer *renderer,bool value){
+    SDL_RenderSetVSync(renderer->renderer,value);
+}
+
+void RendererSetViewport(Renderer *renderer,Texture *target,Rect *rect){
+    FlushBlitBuffer(renderer);
+    target = GetTarget(renderer,target);
+    target->has_viewport = rect != NULL;
+    if(rect != NULL) target->viewport = *rect;
+}
+
+
+void ClearColor(Renderer *renderer,Color color){
+    FlushBlitBuffer(renderer);
+
+    SDL_SetRenderDrawColor(renderer->renderer,color.r,color.g,color.b,color.a);
+
+    //SDL_RenderClear ignores the clip rect, GL clears only the scissored area
+    Texture *target = renderer->target;
+    if(target->clipping || target->has_viewport){
+        ApplyClip(renderer,target);
+        SDL_SetRenderDrawBlendMode(renderer->renderer,SDL_BLENDMODE_NONE);
+        SDL_RenderFillRect(renderer->renderer,NULL);
+    }
+    else{
+        SDL_RenderClear(renderer->renderer);
+    }
+}
+
+void ClearRGBA(Renderer *renderer,uint8_t r,uint8_t g,uint8_t b,uint8_t a){
+    ClearColor(renderer,(Color){r,g,b,a});
+}
+
+void Flip(Renderer *renderer){
+    FlushBlitBuffer(renderer);
+    SDL_RenderPresent(renderer->renderer);
+
+    int width,height;
+    SDL_GetRendererOutputSize(renderer->renderer,&width,&height);
+    renderer->screen.width = width;
+    renderer->screen.height = height;
+}
+
+
+void DrawFilledRectangle(Renderer *renderer,Rect *rect,Color color){
+    Vector2 corners[4] = {
+        {rect->x,rect->y},
+        {rect->x + rect->w,rect->y},
+        {rect->x + rect->w,rect->y + rect->h},
+        {rect->x,rect->y + rect->h}
+    };
+    BatchQuad(renderer,NULL,corners,NULL,color);
+}
+
+void DrawFilledRectangles(Renderer *renderer,Rect *rects,unsigned int count,Color color){
+    for(unsigned int i=0; i<count; ++i){
+        DrawFilledRectangle(renderer,&rects[i],color);
+    }
+}
+
+void DrawRectangle(Renderer *renderer,Rect *rect,Color color){
+    Vector2 vertices[4] = {
+        {rect->x,rect->y},
+        {rect->x + rect->w,rect->y},
+        {rect->x + rect->w,rect->y + rect->h},
+        {rect->x,rect->y + rect->h}
+    };
+    DrawPolygon(renderer,vertices,4,color);
+}
+
+void DrawRectangles(Renderer *renderer,Rect *rects,unsigned int count,Color color){
+    for(unsigned int i=0; i<count; ++i){
+        DrawRectangle(renderer,&rects[i],color);
+    }
+}
+
+void DrawFilledTriangle(Renderer *renderer,Vector2 vertex1,Vector2 vertex2,Vector2 vertex3,Color color){
+    Vector2 vertices[3] = {vertex1,vertex2,vertex3};
+    DrawFilledPolygon(renderer,vertices,3,color);
+}
+
+void DrawTriangle(Renderer *renderer,Vector2 vertex1,Vector2 vertex2,Vector2 vertex3,Color color){
+    Vector2 vertices[3] = {vertex1,vertex2,vertex3};
+    DrawPolygon(renderer,vertices,3,color);
+}
+
+static int ArcPoints(Vector2 *points,Vector2 center,float radius,float start_angle,float end_angle){
+    float start = start_angle * (float)M_PI / 180.0f;
+    float end = end_angle * (float)M_PI / 180.0f;
+    int segments = (int)ceilf(CIRCLE_SEGMENTS * fabsf(end - start) / (2.0f * (float)M_PI));
+    if(segments < 1) segments = 1;
+    if(segments > MAX_SHAPE_POINTS - 2) segments = MAX_SHAPE_POINTS - 2;
+
+    for(int i=0; i<=segments; ++i){
+        float angle = start + (end - start) * i / segments;
+        points[i] = (Vector2){center.x + cosf(angle) * radius,center.y + sinf(angle) * radius};
+    }
+    return segments + 1;
+}
+
+void DrawFilledCircle(Renderer *renderer,Vector2 center,float radius,Color color){
+    Vector2 points[MAX_SHAPE_POINTS];
+    int count = ArcPoints(points,center,radius,0.0f,360.0f);
+    DrawFilledPolygon(renderer,points,count - 1,color);
+}
+
+void DrawCircle(Renderer *renderer,Vector2 center,float radius,Color color){
+    Vector2 points[MAX_SHAPE_POINTS];
+    int count = ArcPoints(points,center,radius,0.0f,360.0f);
+    DrawPolygon(renderer,points,count - 1,color);
+}
+
+void DrawFilledArc(Renderer *renderer,Vector2 center,float radius,float startAngle,float endAngle,Color color){
+    Vector2 points[MAX_SHAPE_POINTS];
+    int count = ArcPoints(points,center,radius,startAngle,endAngle);
+    points[count++] = center;
+    DrawFilledPolygon(renderer,points,count,color);
+}
+
+void DrawArc(Renderer *renderer,Vector2 center,float radius,float startAngle,float endAngle,Color color){
+    Vector2 points[MAX_SHAPE_POINTS];
+    int count = ArcPoints(points,center,radius,startAngle,endAngle);
+    DrawLines(renderer,points,count,color);
+}
+
+static void StrokeLines(Renderer *renderer,Vector2 *points,unsigned int count,bool closed,Color color){
+    if(count == 0) return;
+    FlushBlitBuffer(renderer);
+    ApplyState(renderer,NULL);
+    SDL_SetRenderDrawColor(renderer->renderer,color.r,color.g,color.b,color.a);
+
+    SDL_FPoint buffer[MAX_SHAPE_POINTS + 1];
+    unsigned int total = 0;
+    for(unsigned int i=0; i<count && total<MAX_SHAPE_POINTS; ++i){
+        buffer[total++] = MapPoint(renderer->target,points[i]);
+    }
+    if(closed) buffer[total++] = buffer[0];
+
+    SDL_RenderDrawLinesF(renderer->renderer,buffer,total);
+}
+
+void DrawPixel(Renderer *renderer,Vector2 point,Color color){
+    FlushBlitBuffer(renderer);
+    ApplyState(renderer,NULL);
+    SDL_SetRenderDrawColor(renderer->renderer,color.r,color.g,color.b,color.a);
+    SDL_FPoint position = MapPoint(renderer->target,point);
+    SDL_RenderDrawPointF(renderer->renderer,position.x,position.y);
+}
+
+void DrawLine(Renderer *renderer,Vector2 point1,Vector2 point2,Color color){
+    Vector2 points[2] = {point1,point2};
+    StrokeLines(renderer,points,2,false,color);
+}
+
+void DrawLines(Renderer *renderer,Vector2 *points,unsigned int points_count,Color color){
+    StrokeLines(renderer,points,points_count,false,color);
+}
+
+void DrawPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color){
+    StrokeLines(renderer,vertices,vertices_count,true,color);
+}
+
+//fanned from the first vertex, so the polygon has to be convex
+void DrawFilledPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color){
+    if(vertices_count < 3) return;
+
+    int *indices;
+    int base;
+    SDL_Vertex *batch = BatchReserve(renderer,NULL,vertices_count,(vertices_count - 2) * 3,&indices,&base);
+
+    for(unsigned int i=0; i<vertices_count; ++i){
+        batch[i].position = MapPoint(renderer->target,vertices[i]);
+        batch[i].color = (SDL_Color){color.r,color.g,color.b,color.a};
+        batch[i].tex_coord = (SDL_FPoint){0.0f,0.0f};
+    }
+    for(unsigned int i=0; i+2<vertices_count; ++i){
+        indices[i*3] = base;
+        indices[i*3+1] = base + i + 1;
+        indices[i*3+2] = base + i + 2;
+    }
+}
+
+void Geometry(Renderer *renderer,Texture *texture,Vertex *vertices,unsigned int vertices_count,unsigned *indices,unsigned int indices_count){
+    unsigned int count = indices != NULL ? indices_count : vertices_count;
+    if(count < 3) return;
+
+    int *batch_indices;
+    int base;
+    SDL_Vertex *batch = BatchReserve(renderer,texture,vertices_count,count,&batch_indices,&base);
+
+    for(unsigned int i=0; i<vertices_count; ++i){
+        batch[i].position = MapPoint(renderer->target,vertices[i].position);
+        batch[i].color = (SDL_Color){vertices[i].color.r,vertices[i].color.g,vertices[i].color.b,vertices[i].color.a};
+        batch[i].tex_coord = (SDL_FPoint){vertices[i].texcoord.x,vertices[i].texcoord.y};
+    }
+    for(unsigned int i=0; i<count; ++i){
+        batch_indices[i] = base + (indices != NULL ? (int)indices[i] : (int)i);
+    }
+}
+
+void Blit(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect){
+    Rect src = src_rect != NULL ? *src_rect : (Rect){0.0f,0.0f,texture->width,texture->height};
+    Rect dst = dst_rect != NULL ? *dst_rect : (Rect){0.0f,0.0f,src.w,src.h};
+
+    float u0 = src.x / texture->width;
+    float v0 = src.y / texture->height;
+    float u1 = (src.x + src.w) / texture->width;
+    float v1 = (src.y + src.h) / texture->height;
+
+    Vector2 corners[4] = {{dst.x,dst.y},{dst.x + dst.w,dst.y},{dst.x + dst.w,dst.y + dst.h},{dst.x,dst.y + dst.h}};
+    Vector2 texcoords[4] = {{u0,v0},{u1,v0},{u1,v1},{u0,v1}};
+    BatchQuad(renderer,texture,corners,texcoords,(Color){255,255,255,255});
+}
+
+void BlitEx(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect,float angle,Vector2 *center,FlipFlag flags){
+    Rect src = src_rect != NULL ? *src_rect : (Rect){0.0f,0.0f,texture->width,texture->height};
+    Rect dst = dst_rect != NULL ? *dst_rect : (Rect){0.0f,0.0f,src.w,src.h};
+    Vector2 pivot = center != NULL ? *center : (Vector2){dst.w * 0.5f,dst.h * 0.5f};
+
+    float u0 = src.x / texture->width;
+    float v0 = src.y / texture->height;
+    float u1 = (src.x + src.w) / texture->width;
+    float v1 = (src.y + src.h) / texture->height;
+    if(flags & FLIP_HORIZONTAL){float u = u0; u0 = u1; u1 = u;}
+    if(flags & FLIP_VERTICAL){float v = v0; v0 = v1; v1 = v;}
+
+    float radians = angle * (float)M_PI / 180.0f;
+    float c = cosf(radians);
+    float s = sinf(radians);
+    Vector2 offsets[4] = {{0.0f,0.0f},{dst.w,0.0f},{dst.w,dst.h},{0.0f,dst.h}};
+    Vector2 texcoords[4] = {{u0,v0},{u1,v0},{u1,v1},{u0,v1}};
+    Vector2 corners[4];
+
+    for(int i=0; i<4; ++i){
+        float x = offsets[i].x - pivot.x;
+        float y = offsets[i].y - pivot.y;
+        corners[i] = (Vector2){dst.x + pivot.x + x * c - y * s,dst.y + pivot.y + x * s + y * c};
+    }
+
+    BatchQuad(renderer,texture,corners,texcoords,(Color){255,255,255,255});
+}
+
+
+//text would need SDL_ttf, which this backend does not depend on, so fonts never open
+
+bool GlyphIsProvided(Font *font,int char_code){
+    return false;
+}
+
+void GlyphMetrics(Font *font,int char_code,int *advance,int *minx,int *maxx,int *miny,int *maxy){
+    if(advance != NULL) *advance = 0;
+    if(minx != NULL) *minx = 0;
+    if(maxx != NULL) *maxx = 0;
+    if(miny != NULL) *miny = 0;
+    if(maxy != NULL) *maxy = 0;
+}
+
+void SetFontKerning(Font *font,bool allowed){
+}
+
+void SetFontHeight(Font *font,int height){
+}
+
+Font* OpenFont(const char *fileName,int height){
+    return NULL;
+}
+
+void CloseFont(Font *font){
+}
+
+void SizeText(Font *font,const uint16_t *text,int *width,int *height){
+    if(width != NULL) *width = 0;
+    if(height != NULL) *height = 0;
+}
+
+Texture* RenderGlyph(Renderer *renderer,Font *font,uint16_t char_code,Color color){
+    return NULL;
+}
+
+Texture* RenderText(Renderer *renderer,Font *font,const uint16_t *text,Color color){
+    return NULL;
+}
+
+Texture* RenderTextMono(Renderer *renderer,Font *font,const uint16_t *text,Color color){
+    return NULL;
+}
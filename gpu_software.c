@@ -0,0 +1,968 @@
+#include <GPU.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFTWARE_SSE2
+#endif
+
+#define MAX_POLYGON_EDGES 64
+#define CIRCLE_SEGMENTS 48
+
+struct _Texture{
+    int width;
+    int height;
+    PixelFormat format;
+    bool mipmap;
+    bool framebuffer;
+
+    Filter min_filter;
+    Filter mag_filter;
+    Wrap wrap_x;
+    Wrap wrap_y;
+
+    //every format is stored as 8 bit RGBA, byte order r,g,b,a
+    uint32_t *pixels;
+
+    BlendMode blend_mode;
+    bool blending;
+    bool clipping;
+    Rect clip;
+    bool has_viewport;
+    Rect viewport;
+};
+
+struct _Renderer{
+    SDL_Window *window;
+    Texture *screen;
+    Texture *target;
+    bool vsync;
+
+    //one row of source pixels handed to the span blender
+    uint32_t *row;
+    int row_capacity;
+};
+
+typedef struct _ClipBox{
+    int x0,y0,x1,y1;
+}ClipBox;
+
+
+static inline uint32_t PackColor(Color color){
+    uint32_t pixel;
+    memcpy(&pixel,&color,sizeof(pixel));
+    return pixel;
+}
+
+static inline Color UnpackColor(uint32_t pixel){
+    Color color;
+    memcpy(&color,&pixel,sizeof(color));
+    return color;
+}
+
+static inline int Div255(int value){
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+static uint32_t* GetRow(Renderer *renderer,int count){
+    if(count > renderer->row_capacity){
+        renderer->row_capacity = count * 2;
+        renderer->row = realloc(renderer->row,sizeof(uint32_t) * renderer->row_capacity);
+    }
+    return renderer->row;
+}
+
+static Texture* GetTarget(Renderer *renderer,Texture *target){
+    return target != NULL ? target : renderer->screen;
+}
+
+static bool IsBlendNormal(Texture *target){
+    BlendMode normal = GetBlendModeByPreset(BLEND_NORMAL);
+    return target->blending && memcmp(&target->blend_mode,&normal,sizeof(BlendMode)) == 0;
+}
+
+static bool IsBlendSet(Texture *target){
+    BlendMode set = GetBlendModeByPreset(BLEND_SET);
+    return !target->blending || memcmp(&target->blend_mode,&set,sizeof(BlendMode)) == 0;
+}
+
+
+//span writers, the SSE2 paths handle four pixels per iteration
+
+static void FillSpan(uint32_t *dst,uint32_t pixel,int count){
+    int i = 0;
+#ifdef SOFTWARE_SSE2
+    __m128i value = _mm_set1_epi32((int)pixel);
+    for(; i+4 <= count; i+=4){
+        _mm_storeu_si128((__m128i*)(dst+i),value);
+    }
+#endif
+    for(; i<count; ++i){
+        dst[i] = pixel;
+    }
+}
+
+#ifdef SOFTWARE_SSE2
+static inline __m128i Div255Epi16(__m128i value){
+    value = _mm_add_epi16(value,_mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(value,_mm_srli_epi16(value,8)),8);
+}
+
+//src * a + dst * (255 - a) for two unpacked pixels, a is broadcast per pixel
+static inline __m128i BlendEpi16(__m128i src,__m128i dst,__m128i alpha){
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255),alpha);
+    return Div255Epi16(_mm_add_epi16(_mm_mullo_epi16(src,alpha),_mm_mullo_epi16(dst,inverse)));
+}
+
+static inline __m128i BroadcastAlpha(__m128i pixels){
+    pixels = _mm_shufflelo_epi16(pixels,_MM_SHUFFLE(3,3,3,3));
+    return _mm_shufflehi_epi16(pixels,_MM_SHUFFLE(3,3,3,3));
+}
+#endif
+
+static inline uint32_t BlendNormalPixel(uint32_t src,uint32_t dst){
+    Color s = UnpackColor(src);
+    Color d = UnpackColor(dst);
+    int a = s.a;
+    return PackColor((Color){
+        Div255(s.r * a + d.r * (255 - a)),
+        Div255(s.g * a + d.g * (255 - a)),
+        Div255(s.b * a + d.b * (255 - a)),
+        Div255(s.a * a + d.a * (255 - a))
+    });
+}
+
+static void BlendSpanColorNormal(uint32_t *dst,uint32_t pixel,int count){
+    int i = 0;
+#ifdef SOFTWARE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)pixel),zero);
+    __m128i alpha = BroadcastAlpha(src);
+    for(; i+4 <= count; i+=4){
+        __m128i d = _mm_loadu_si128((__m128i*)(dst+i));
+        __m128i lo = BlendEpi16(src,_mm_unpacklo_epi8(d,zero),alpha);
+        __m128i hi = BlendEpi16(src,_mm_unpackhi_epi8(d,zero),alpha);
+        _mm_storeu_si128((__m128i*)(dst+i),_mm_packus_epi16(lo,hi));
+    }
+#endif
+    for(; i<count; ++i){
+        dst[i] = BlendNormalPixel(pixel,dst[i]);
+    }
+}
+
+static void BlendSpanNormal(uint32_t *dst,const uint32_t *src,int count){
+    int i = 0;
+#ifdef SOFTWARE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    for(; i+4 <= count; i+=4){
+        __m128i s = _mm_loadu_si128((const __m128i*)(src+i));
+        __m128i d = _mm_loadu_si128((__m128i*)(dst+i));
+        __m128i s_lo = _mm_unpacklo_epi8(s,zero);
+        __m128i s_hi = _mm_unpackhi_epi8(s,zero);
+        __m128i lo = BlendEpi16(s_lo,_mm_unpacklo_epi8(d,zero),BroadcastAlpha(s_lo));
+        __m128i hi = BlendEpi16(s_hi,_mm_unpackhi_epi8(d,zero),BroadcastAlpha(s_hi));
+        _mm_storeu_si128((__m128i*)(dst+i),_mm_packus_epi16(lo,hi));
+    }
+#endif
+    for(; i<count; ++i){
+        uint32_t alpha = src[i] >> 24;
+        if(alpha == 255) dst[i] = src[i];
+        else if(alpha != 0) dst[i] = BlendNormalPixel(src[i],dst[i]);
+    }
+}
+
+static int BlendFactor(uint32_t function,Color s,Color d,int channel){
+    int src_channel = ((uint8_t*)&s)[channel];
+    int dst_channel = ((uint8_t*)&d)[channel];
+    switch(function){
+        case FUNC_ZERO:                return 0;
+        case FUNC_ONE:                 return 255;
+        case FUNC_SRC_COLOR:           return src_channel;
+        case FUNC_ONE_MINUS_SRC_COLOR: return 255 - src_channel;
+        case FUNC_DST_COLOR:           return dst_channel;
+        case FUNC_ONE_MINUS_DST_COLOR: return 255 - dst_channel;
+        case FUNC_SRC_ALPHA:           return s.a;
+        case FUNC_ONE_MINUS_SRC_ALPHA: return 255 - s.a;
+        case FUNC_DST_ALPHA:           return d.a;
+        case FUNC_ONE_MINUS_DST_ALPHA: return 255 - d.a;
+    }
+    return 255;
+}
+
+static int BlendEquationApply(uint32_t equation,int src,int dst){
+    int value;
+    switch(equation){
+        case EQ_SUBTRACT:         value = src - dst; break;
+        case EQ_REVERSE_SUBTRACT: value = dst - src; break;
+        case EQ_MIN:              value = src < dst ? src : dst; break;
+        case EQ_MAX:              value = src > dst ? src : dst; break;
+        default:                  value = src + dst; break;
+    }
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static uint32_t BlendPixel(BlendMode *mode,uint32_t src,uint32_t dst){
+    Color s = UnpackColor(src);
+    Color d = UnpackColor(dst);
+    uint8_t out[4];
+
+    for(int channel=0; channel<4; ++channel){
+        uint32_t src_function = channel < 3 ? mode->srcRGB : mode->srcAlpha;
+        uint32_t dst_function = channel < 3 ? mode->dstRGB : mode->dstAlpha;
+        uint32_t equation = channel < 3 ? mode->modeRGB : mode->modeAlpha;
+
+        int src_value = Div255(((uint8_t*)&s)[channel] * BlendFactor(src_function,s,d,channel));
+        int dst_value = Div255(((uint8_t*)&d)[channel] * BlendFactor(dst_function,s,d,channel));
+        out[channel] = BlendEquationApply(equation,src_value,dst_value);
+    }
+
+    uint32_t pixel;
+    memcpy(&pixel,out,sizeof(pixel));
+    return pixel;
+}
+
+static void WriteSpanColor(Texture *target,uint32_t *dst,Color color,int count){
+    if(count <= 0) return;
+
+    if(IsBlendSet(target) || (IsBlendNormal(target) && color.a == 255)){
+        FillSpan(dst,PackColor(color),count);
+    }
+    else if(IsBlendNormal(target)){
+        if(color.a != 0) BlendSpanColorNormal(dst,PackColor(color),count);
+    }
+    else{
+        uint32_t pixel = PackColor(color);
+        for(int i=0; i<count; ++i){
+            dst[i] = BlendPixel(&target->blend_mode,pixel,dst[i]);
+        }
+    }
+}
+
+static void WriteSpan(Texture *target,uint32_t *dst,const uint32_t *src,int count){
+    if(count <= 0) return;
+
+    if(IsBlendSet(target)){
+        memcpy(dst,src,sizeof(uint32_t) * count);
+    }
+    else if(IsBlendNormal(target)){
+        BlendSpanNormal(dst,src,count);
+    }
+    else{
+        for(int i=0; i<count; ++i){
+            dst[i] = BlendPixel(&target->blend_mode,src[i],dst[i]);
+        }
+    }
+}
+
+
+//coordinates are mapped through the viewport and everything is clipped to the viewport and the clip rect
+
+static ClipBox GetClipBox(Texture *target){
+    ClipBox box = {0,0,target->width,target->height};
+
+    if(target->has_viewport){
+        box.x0 = fmaxf(box.x0,ceilf(target->viewport.x - 0.5f));
+        box.y0 = fmaxf(box.y0,ceilf(target->viewport.y - 0.5f));
+        box.x1 = fminf(box.x1,ceilf(target->viewport.x + target->viewport.w - 0.5f));
+        box.y1 = fminf(box.y1,ceilf(target->viewport.y + target->viewport.h - 0.5f));
+    }
+
+    if(target->clipping){
+        box.x0 = fmaxf(box.x0,ceilf(target->clip.x - 0.5f));
+        box.y0 = fmaxf(box.y0,ceilf(target->clip.y - 0.5f));
+        box.x1 = fminf(box.x1,ceilf(target->clip.x + target->clip.w - 0.5f));
+        box.y1 = fminf(box.y1,ceilf(target->clip.y + target->clip.h - 0.5f));
+    }
+
+    return box;
+}
+
+static inline Vector2 MapPoint(Texture *target,Vector2 point){
+    if(!target->has_viewport) return point;
+    return (Vector2){
+        target->viewport.x + point.x * target->viewport.w / target->width,
+        target->viewport.y + point.y * target->viewport.h / target->height
+    };
+}
+
+static inline Rect MapRect(Texture *target,Rect rect){
+    Vector2 position = MapPoint(target,(Vector2){rect.x,rect.y});
+    Vector2 end = MapPoint(target,(Vector2){rect.x + rect.w,rect.y + rect.h});
+    return (Rect){position.x,position.y,end.x - position.x,end.y - position.y};
+}
+
+
+static uint32_t SampleNearest(Texture *texture,float u,float v){
+    int x = (int)floorf(u);
+    int y = (int)floorf(v);
+
+    if(texture->wrap_x == WRAP_REPEAT) x = ((x % texture->width) + texture->width) % texture->width;
+    else x = x < 0 ? 0 : (x >= texture->width ? texture->width - 1 : x);
+
+    if(texture->wrap_y == WRAP_REPEAT) y = ((y % texture->height) + texture->height) % texture->height;
+    else y = y < 0 ? 0 : (y >= texture->height ? texture->height - 1 : y);
+
+    return texture->pixels[y * texture->width + x];
+}
+
+static uint32_t SampleLinear(Texture *texture,float u,float v){
+    u -= 0.5f;
+    v -= 0.5f;
+    float x = floorf(u);
+    float y = floorf(v);
+    int fx = (int)((u - x) * 256.0f);
+    int fy = (int)((v - y) * 256.0f);
+
+    Color c00 = UnpackColor(SampleNearest(texture,x + 0.5f,y + 0.5f));
+    Color c10 = UnpackColor(SampleNearest(texture,x + 1.5f,y + 0.5f));
+    Color c01 = UnpackColor(SampleNearest(texture,x + 0.5f,y + 1.5f));
+    Color c11 = UnpackColor(SampleNearest(texture,x + 1.5f,y + 1.5f));
+
+    uint8_t out[4];
+    for(int i=0; i<4; ++i){
+        int top = ((uint8_t*)&c00)[i] * (256 - fx) + ((uint8_t*)&c10)[i] * fx;
+        int bottom = ((uint8_t*)&c01)[i] * (256 - fx) + ((uint8_t*)&c11)[i] * fx;
+        out[i] = (top * (256 - fy) + bottom * fy) >> 16;
+    }
+
+    uint32_t pixel;
+    memcpy(&pixel,out,sizeof(pixel));
+    return pixel;
+}
+
+static inline uint32_t Modulate(uint32_t pixel,Color color){
+    if(PackColor(color) == 0xFFFFFFFFu) return pixel;
+    Color c = UnpackColor(pixel);
+    return PackColor((Color){Div255(c.r * color.r),Div255(c.g * color.g),Div255(c.b * color.b),Div255(c.a * color.a)});
+}
+
+
+//scanline polygon fill with the even-odd rule, pixel centers are sampled at +0.5
+static void FillPolygon(Renderer *renderer,Vector2 *vertices,unsigned int count,Color color){
+    Texture *target = renderer->target;
+    if(count < 3) return;
+
+    Vector2 points[MAX_POLYGON_EDGES];
+    if(count > MAX_POLYGON_EDGES) count = MAX_POLYGON_EDGES;
+
+    float min_y = INFINITY;
+    float max_y = -INFINITY;
+    for(unsigned int i=0; i<count; ++i){
+        points[i] = MapPoint(target,vertices[i]);
+        min_y = fminf(min_y,points[i].y);
+        max_y = fmaxf(max_y,points[i].y);
+    }
+
+    ClipBox box = GetClipBox(target);
+    int y0 = fmaxf(ceilf(min_y - 0.5f),box.y0);
+    int y1 = fminf(ceilf(max_y - 0.5f),box.y1);
+
+    float crossings[MAX_POLYGON_EDGES];
+
+    for(int y=y0; y<y1; ++y){
+        float center = y + 0.5f;
+        int crossings_count = 0;
+
+        for(unsigned int i=0; i<count; ++i){
+            Vector2 a = points[i];
+            Vector2 b = points[(i + 1) % count];
+            if((a.y <= center && b.y > center) || (b.y <= center && a.y > center)){
+                float x = a.x + (center - a.y) * (b.x - a.x) / (b.y - a.y);
+                int j = crossings_count++;
+                while(j > 0 && crossings[j-1] > x){
+                    crossings[j] = crossings[j-1];
+                    j--;
+                }
+                crossings[j] = x;
+            }
+        }
+
+        uint32_t *row = target->pixels + y * target->width;
+        for(int i=0; i+1<crossings_count; i+=2){
+            int x0 = fmaxf(ceilf(crossings[i] - 0.5f),box.x0);
+            int x1 = fminf(ceilf(crossings[i+1] - 0.5f),box.x1);
+            WriteSpanColor(target,row + x0,color,x1 - x0);
+        }
+    }
+}
+
+static void StrokeLine(Renderer *renderer,Vector2 a,Vector2 b,Color color,bool last){
+    Texture *target = renderer->target;
+    ClipBox box = GetClipBox(target);
+
+    a = MapPoint(target,a);
+    b = MapPoint(target,b);
+
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    int steps = (int)ceilf(fmaxf(fabsf(dx),fabsf(dy)));
+    if(steps == 0) steps = 1;
+
+    int end = last ? steps : steps - 1;
+    for(int i=0; i<=end; ++i){
+        int x = (int)floorf(a.x + dx * i / steps);
+        int y = (int)floorf(a.y + dy * i / steps);
+        if(x < box.x0 || x >= box.x1 || y < box.y0 || y >= box.y1) continue;
+        WriteSpanColor(target,target->pixels + y * target->width + x,color,1);
+    }
+}
+
+static void RasterTriangle(Renderer *renderer,Texture *texture,Vertex *v0,Vertex *v1,Vertex *v2){
+    Texture *target = renderer->target;
+    ClipBox box = GetClipBox(target);
+
+    Vector2 p0 = MapPoint(target,v0->position);
+    Vector2 p1 = MapPoint(target,v1->position);
+    Vector2 p2 = MapPoint(target,v2->position);
+
+    float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if(area == 0.0f) return;
+
+    //keep a consistent winding so the top-left rule works for both orientations
+    if(area < 0.0f){
+        Vertex *vertex = v1; v1 = v2; v2 = vertex;
+        Vector2 point = p1; p1 = p2; p2 = point;
+        area = -area;
+    }
+
+    int x0 = fmaxf(ceilf(fminf(p0.x,fminf(p1.x,p2.x)) - 0.5f),box.x0);
+    int x1 = fminf(ceilf(fmaxf(p0.x,fmaxf(p1.x,p2.x)) - 0.5f),box.x1);
+    int y0 = fmaxf(ceilf(fminf(p0.y,fminf(p1.y,p2.y)) - 0.5f),box.y0);
+    int y1 = fminf(ceilf(fmaxf(p0.y,fmaxf(p1.y,p2.y)) - 0.5f),box.y1);
+    if(x0 >= x1 || y0 >= y1) return;
+
+    Vector2 edges[3][2] = {{p1,p2},{p2,p0},{p0,p1}};
+    bool top_left[3];
+    for(int i=0; i<3; ++i){
+        float ex = edges[i][1].x - edges[i][0].x;
+        float ey = edges[i][1].y - edges[i][0].y;
+        top_left[i] = (ey == 0.0f && ex < 0.0f) || ey > 0.0f;
+    }
+
+    float inverse = 1.0f / area;
+    uint32_t *source = GetRow(renderer,x1 - x0);
+
+    for(int y=y0; y<y1; ++y){
+        float py = y + 0.5f;
+        int start = -1;
+        int count = 0;
+
+        for(int x=x0; x<x1; ++x){
+            float px = x + 0.5f;
+            float w[3];
+            bool inside = true;
+            for(int i=0; i<3; ++i){
+                w[i] = (edges[i][1].x - edges[i][0].x) * (py - edges[i][0].y) - (edges[i][1].y - edges[i][0].y) * (px - edges[i][0].x);
+                if(w[i] < 0.0f || (w[i] == 0.0f && !top_left[i])) inside = false;
+            }
+
+            if(!inside){
+                if(count > 0) break;
+                continue;
+            }
+            if(start < 0) start = x;
+
+            float b0 = w[0] * inverse;
+            float b1 = w[1] * inverse;
+            float b2 = w[2] * inverse;
+
+            Color color = {
+                v0->color.r * b0 + v1->color.r * b1 + v2->color.r * b2 + 0.5f,
+                v0->color.g * b0 + v1->color.g * b1 + v2->color.g * b2 + 0.5f,
+                v0->color.b * b0 + v1->color.b * b1 + v2->color.b * b2 + 0.5f,
+                v0->color.a * b0 + v1->color.a * b1 + v2->color.a * b2 + 0.5f
+            };
+
+            if(texture != NULL){
+                float u = (v0->texcoord.x * b0 + v1->texcoord.x * b1 + v2->texcoord.x * b2) * texture->width;
+                float v = (v0->texcoord.y * b0 + v1->texcoord.y * b1 + v2->texcoord.y * b2) * texture->height;
+                uint32_t texel = texture->mag_filter == FILTER_NEAREST ? SampleNearest(texture,u,v) : SampleLinear(texture,u,v);
+                source[count++] = Modulate(texel,color);
+            }
+            else{
+                source[count++] = PackColor(color);
+            }
+        }
+
+        if(count > 0){
+            WriteSpan(target,target->pixels + y * target->width + start,source,count);
+        }
+    }
+}
+
+
+BlendMode GetBlendModeByPreset(BlendModePreset preset){
+    switch(preset){
+        case BLEND_PREMULTIPLIED_ALPHA: return (BlendMode){FUNC_ONE,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ONE,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        case BLEND_MULTIPLY:            return (BlendMode){FUNC_DST_COLOR,FUNC_ZERO,FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        case BLEND_ADD:                 return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE,FUNC_SRC_ALPHA,FUNC_ONE,EQ_ADD,EQ_ADD};
+        case BLEND_SUBTRACT:            return (BlendMode){FUNC_ONE,FUNC_ONE,FUNC_ONE,FUNC_ONE,EQ_SUBTRACT,EQ_SUBTRACT};
+        case BLEND_MOD_ALPHA:           return (BlendMode){FUNC_ZERO,FUNC_ONE,FUNC_ZERO,FUNC_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        case BLEND_SET_ALPHA:           return (BlendMode){FUNC_ZERO,FUNC_ONE,FUNC_ONE,FUNC_ZERO,EQ_ADD,EQ_ADD};
+        case BLEND_SET:                 return (BlendMode){FUNC_ONE,FUNC_ZERO,FUNC_ONE,FUNC_ZERO,EQ_ADD,EQ_ADD};
+        case BLEND_NORMAL_KEEP_ALPHA:   return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ZERO,FUNC_ONE,EQ_ADD,EQ_ADD};
+        case BLEND_NORMAL_ADD_ALPHA:    return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ONE,FUNC_ONE,EQ_ADD,EQ_ADD};
+        case BLEND_NORMAL_FACTOR_ALPHA: return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_ONE,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+        default:                        return (BlendMode){FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,FUNC_SRC_ALPHA,FUNC_ONE_MINUS_SRC_ALPHA,EQ_ADD,EQ_ADD};
+    }
+}
+
+void SetBlendFunction(Renderer *renderer,Texture *target,BlendFunction srcRGB,BlendFunction dstRGB,BlendFunction srcAlpha,BlendFunction dstAlpha){
+    target = GetTarget(renderer,target);
+    target->blend_mode.srcRGB = srcRGB;
+    target->blend_mode.dstRGB = dstRGB;
+    target->blend_mode.srcAlpha = srcAlpha;
+    target->blend_mode.dstAlpha = dstAlpha;
+}
+
+void SetBlendEquation(Renderer *renderer,Texture *target,BlendEquation modeRGB,BlendEquation modeAlpha){
+    target = GetTarget(renderer,target);
+    target->blend_mode.modeRGB = modeRGB;
+    target->blend_mode.modeAlpha = modeAlpha;
+}
+
+void SetBlendModeByPreset(Renderer *renderer,Texture *target,BlendModePreset preset){
+    GetTarget(renderer,target)->blend_mode = GetBlendModeByPreset(preset);
+}
+
+void SetBlendMode(Renderer *renderer,Texture *target,BlendMode blend_mode){
+    GetTarget(renderer,target)->blend_mode = blend_mode;
+}
+
+void SetBlending(Renderer *renderer,Texture *target,bool blending){
+    GetTarget(renderer,target)->blending = blending;
+}
+
+
+void SetClip(Renderer *renderer,Texture *target,Rect *rect){
+    target = GetTarget(renderer,target);
+    target->clipping = true;
+    target->clip = *rect;
+}
+
+void UnSetClip(Renderer *renderer,Texture *target){
+    GetTarget(renderer,target)->clipping = false;
+}
+
+
+Texture* CreateTexture(Renderer *renderer,int width,int height,PixelFormat format,bool mipmap,bool framebuffer){
+    if(width <= 0 || height <= 0) return NULL;
+
+    Texture *texture = malloc(sizeof(Texture));
+    texture->width = width;
+    texture->height = height;
+    texture->format = format;
+    texture->mipmap = mipmap;
+    texture->framebuffer = framebuffer;
+    texture->min_filter = FILTER_LINEAR;
+    texture->mag_filter = FILTER_LINEAR;
+    texture->wrap_x = WRAP_CLAMP_TO_EDGE;
+    texture->wrap_y = WRAP_CLAMP_TO_EDGE;
+    texture->pixels = calloc((size_t)width * height,sizeof(uint32_t));
+    texture->blend_mode = GetBlendModeByPreset(BLEND_NORMAL);
+    texture->blending = true;
+    texture->clipping = false;
+    texture->clip = (Rect){0.0f,0.0f,width,height};
+    texture->has_viewport = false;
+    texture->viewport = (Rect){0.0f,0.0f,width,height};
+
+    return texture;
+}
+
+Texture* LoadTexture(Renderer *renderer,const char *fileName,bool mipmap,bool framebuffer){
+    SDL_Surface *surface = SDL_LoadBMP(fileName);
+    if(surface == NULL) return NULL;
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface,SDL_PIXELFORMAT_RGBA32,0);
+    SDL_FreeSurface(surface);
+    if(converted == NULL) return NULL;
+
+    Texture *texture = CreateTexture(renderer,converted->w,converted->h,PIXEL_FORMAT_RGBA,mipmap,framebuffer);
+    for(int y=0; y<converted->h; ++y){
+        memcpy(texture->pixels + y * texture->width,(uint8_t*)converted->pixels + y * converted->pitch,converted->w * sizeof(uint32_t));
+    }
+    SDL_FreeSurface(converted);
+
+    return texture;
+}
+
+void TextureFree(Texture *texture){
+    if(texture == NULL) return;
+    free(texture->pixels);
+    free(texture);
+}
+
+void SetTextureFilter(Texture *texture,Filter min_filter,Filter mag_filter){
+    texture->min_filter = min_filter;
+    texture->mag_filter = mag_filter;
+}
+
+void SetTextureWrap(Texture *texture,Wrap wrap_x,Wrap wrap_y){
+    texture->wrap_x = wrap_x;
+    texture->wrap_y = wrap_y;
+}
+
+void GenerateFrameBuffer(Renderer *renderer,Texture *texture){
+    texture->framebuffer = true;
+}
+
+void GenearateMipmap(Renderer *renderer,Texture *texture){
+    texture->mipmap = true;
+}
+
+//the pixels are handed out in place, so reads see what was rendered and writes need no upload
+void LockTexture(Texture *texture,Rect *rect,void **pixels,int *pitch){
+    int x = rect != NULL ? (int)rect->x : 0;
+    int y = rect != NULL ? (int)rect->y : 0;
+    *pixels = texture->pixels + y * texture->width + x;
+    *pitch = texture->width * sizeof(uint32_t);
+}
+
+void UnlockTexture(Texture *texture){
+}
+
+void TextureSize(Texture *texture,int *width,int *height){
+    if(width != NULL) *width = texture->width;
+    if(height != NULL) *height = texture->height;
+}
+
+void TextureFormat(Texture *texture,PixelFormat *format){
+    *format = texture->format;
+}
+
+bool TextureHasFrameBuffer(Texture *texture){
+    return texture->framebuffer;
+}
+
+bool TextureHasMipmap(Texture *texture){
+    return texture->mipmap;
+}
+
+void TextureWrap(Texture *texture,Wrap *wrap_x,Wrap *wrap_y){
+    *wrap_x = texture->wrap_x;
+    *wrap_y = texture->wrap_y;
+}
+
+void TextureFilter(Texture *texture,Filter *min_filter,Filter *mag_filter){
+    *min_filter = texture->min_filter;
+    *mag_filter = texture->mag_filter;
+}
+
+
+Renderer* CreateRenderer(SDL_Window *window,bool vsync){
+    int width = 1;
+    int height = 1;
+    if(window != NULL) SDL_GetWindowSize(window,&width,&height);
+
+    Renderer *renderer = malloc(sizeof(Renderer));
+    renderer->window = window;
+    renderer->screen = CreateTexture(renderer,width,height,PIXEL_FORMAT_RGBA,false,true);
+    renderer->target = renderer->screen;
+    renderer->vsync = vsync;
+    renderer->row = NULL;
+    renderer->row_capacity = 0;
+
+    return renderer;
+}
+
+void RendererFree(Renderer *renderer){
+    TextureFree(renderer->screen);
+    free(renderer->row);
+    free(renderer);
+}
+
+void RendererSetTarget(Renderer *renderer,Texture *target){
+    renderer->target = GetTarget(renderer,target);
+}
+
+void RendererSetVsync(Renderer *renderer,bool value){
+    renderer->vsync = value;
+}
+
+void RendererSetViewport(Renderer *renderer,Texture *target,Rect *rect){
+    target = GetTarget(renderer,target);
+    target->has_viewport = rect != NULL;
+    if(rect != NULL) target->viewport = *rect;
+}
+
+
+void FlushBlitBuffer(Renderer *renderer){
+}
+
+void ClearColor(Renderer *renderer,Color color){
+    Texture *target = renderer->target;
+    ClipBox box = GetClipBox(target);
+    uint32_t pixel = PackColor(color);
+    for(int y=box.y0; y<box.y1; ++y){
+        FillSpan(target->pixels + y * target->width + box.x0,pixel,box.x1 - box.x0);
+    }
+}
+
+void ClearRGBA(Renderer *renderer,uint8_t r,uint8_t g,uint8_t b,uint8_t a){
+    ClearColor(renderer,(Color){r,g,b,a});
+}
+
+//copies the screen to the window surface and follows the window size for the next frame
+void Flip(Renderer *renderer){
+    if(renderer->window == NULL) return;
+
+    SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
+    Texture *screen = renderer->screen;
+
+    if(surface != NULL){
+        int width = surface->w < screen->width ? surface->w : screen->width;
+        int height = surface->h < screen->height ? surface->h : screen->height;
+        SDL_ConvertPixels(width,height,SDL_PIXELFORMAT_RGBA32,screen->pixels,screen->width * sizeof(uint32_t),surface->format->format,surface->pixels,surface->pitch);
+        SDL_UpdateWindowSurface(renderer->window);
+    }
+
+    int width,height;
+    SDL_GetWindowSize(renderer->window,&width,&height);
+    if(width != screen->width || height != screen->height){
+        free(screen->pixels);
+        screen->width = width;
+        screen->height = height;
+        screen->pixels = calloc((size_t)width * height,sizeof(uint32_t));
+        if(!screen->clipping) screen->clip = (Rect){0.0f,0.0f,width,height};
+    }
+}
+
+
+void DrawFilledRectangle(Renderer *renderer,Rect *rect,Color color){
+    Vector2 vertices[4] = {
+        {rect->x,rect->y},
+        {rect->x + rect->w,rect->y},
+        {rect->x + rect->w,rect->y + rect->h},
+        {rect->x,rect->y + rect->h}
+    };
+    FillPolygon(renderer,vertices,4,color);
+}
+
+void DrawFilledRectangles(Renderer *renderer,Rect *rects,unsigned int count,Color color){
+    for(unsigned int i=0; i<count; ++i){
+        DrawFilledRectangle(renderer,&rects[i],color);
+    }
+}
+
+void DrawRectangle(Renderer *renderer,Rect *rect,Color color){
+    Vector2 vertices[4] = {
+        {rect->x,rect->y},
+        {rect->x + rect->w,rect->y},
+        {rect->x + rect->w,rect->y + rect->h},
+        {rect->x,rect->y + rect->h}
+    };
+    DrawPolygon(renderer,vertices,4,color);
+}
+
+void DrawRectangles(Renderer *renderer,Rect *rects,unsigned int count,Color color){
+    for(unsigned int i=0; i<count; ++i){
+        DrawRectangle(renderer,&rects[i],color);
+    }
+}
+
+void DrawFilledTriangle(Renderer *renderer,Vector2 vertex1,Vector2 vertex2,Vector2 vertex3,Color color){
+    Vector2 vertices[3] = {vertex1,vertex2,vertex3};
+    FillPolygon(renderer,vertices,3,color);
+}
+
+void DrawTriangle(Renderer *renderer,Vector2 vertex1,Vector2 vertex2,Vector2 vertex3,Color color){
+    Vector2 vertices[3] = {vertex1,vertex2,vertex3};
+    DrawPolygon(renderer,vertices,3,color);
+}
+
+static int ArcPoints(Vector2 *points,Vector2 center,float radius,float start_angle,float end_angle){
+    float start = start_angle * (float)M_PI / 180.0f;
+    float end = end_angle * (float)M_PI / 180.0f;
+    int segments = (int)ceilf(CIRCLE_SEGMENTS * fabsf(end - start) / (2.0f * (float)M_PI));
+    if(segments < 1) segments = 1;
+    if(segments > MAX_POLYGON_EDGES - 2) segments = MAX_POLYGON_EDGES - 2;
+
+    for(int i=0; i<=segments; ++i){
+        float angle = start + (end - start) * i / segments;
+        points[i] = (Vector2){center.x + cosf(angle) * radius,center.y + sinf(angle) * radius};
+    }
+    return segments + 1;
+}
+
+void DrawFilledCircle(Renderer *renderer,Vector2 center,float radius,Color color){
+    Vector2 points[MAX_POLYGON_EDGES];
+    int count = ArcPoints(points,center,radius,0.0f,360.0f);
+    FillPolygon(renderer,points,count - 1,color);
+}
+
+void DrawCircle(Renderer *renderer,Vector2 center,float radius,Color color){
+    Vector2 points[MAX_POLYGON_EDGES];
+    int count = ArcPoints(points,center,radius,0.0f,360.0f);
+    DrawPolygon(renderer,points,count - 1,color);
+}
+
+void DrawFilledArc(Renderer *renderer,Vector2 center,float radius,float startAngle,float endAngle,Color color){
+    Vector2 points[MAX_POLYGON_EDGES];
+    int count = ArcPoints(points,center,radius,startAngle,endAngle);
+    points[count++] = center;
+    FillPolygon(renderer,points,count,color);
+}
+
+void DrawArc(Renderer *renderer,Vector2 center,float radius,float startAngle,float endAngle,Color color){
+    Vector2 points[MAX_POLYGON_EDGES];
+    int count = ArcPoints(points,center,radius,startAngle,endAngle);
+    DrawLines(renderer,points,count,color);
+}
+
+void DrawPixel(Renderer *renderer,Vector2 point,Color color){
+    StrokeLine(renderer,point,point,color,true);
+}
+
+void DrawLine(Renderer *renderer,Vector2 point1,Vector2 point2,Color color){
+    StrokeLine(renderer,point1,point2,color,true);
+}
+
+void DrawLines(Renderer *renderer,Vector2 *points,unsigned int points_count,Color color){
+    for(unsigned int i=0; i+1<points_count; ++i){
+        StrokeLine(renderer,points[i],points[i+1],color,i+2 == points_count);
+    }
+}
+
+void DrawPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color){
+    for(unsigned int i=0; i<vertices_count; ++i){
+        StrokeLine(renderer,vertices[i],vertices[(i + 1) % vertices_count],color,false);
+    }
+}
+
+void DrawFilledPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color){
+    FillPolygon(renderer,vertices,vertices_count,color);
+}
+
+void Geometry(Renderer *renderer,Texture *texture,Vertex *vertices,unsigned int vertices_count,unsigned *indices,unsigned int indices_count){
+    unsigned int count = indices != NULL ? indices_count : vertices_count;
+    for(unsigned int i=0; i+2<count; i+=3){
+        if(indices != NULL){
+            if(indices[i] >= vertices_count || indices[i+1] >= vertices_count || indices[i+2] >= vertices_count) continue;
+            RasterTriangle(renderer,texture,&vertices[indices[i]],&vertices[indices[i+1]],&vertices[indices[i+2]]);
+        }
+        else{
+            RasterTriangle(renderer,texture,&vertices[i],&vertices[i+1],&vertices[i+2]);
+        }
+    }
+}
+
+void Blit(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect){
+    Texture *target = renderer->target;
+    Rect src = src_rect != NULL ? *src_rect : (Rect){0.0f,0.0f,texture->width,texture->height};
+    Rect dst = dst_rect != NULL ? *dst_rect : (Rect){0.0f,0.0f,src.w,src.h};
+    if(dst.w <= 0.0f || dst.h <= 0.0f) return;
+
+    dst = MapRect(target,dst);
+
+    ClipBox box = GetClipBox(target);
+    int x0 = fmaxf(ceilf(dst.x - 0.5f),box.x0);
+    int x1 = fminf(ceilf(dst.x + dst.w - 0.5f),box.x1);
+    int y0 = fmaxf(ceilf(dst.y - 0.5f),box.y0);
+    int y1 = fminf(ceilf(dst.y + dst.h - 0.5f),box.y1);
+    if(x0 >= x1 || y0 >= y1) return;
+
+    float scale_x = src.w / dst.w;
+    float scale_y = src.h / dst.h;
+    Filter filter = (scale_x < 1.0f || scale_y < 1.0f) ? texture->mag_filter : texture->min_filter;
+
+    //an unscaled blit on whole pixels samples texel centers exactly, so it is a plain copy
+    bool aligned = scale_x == 1.0f && scale_y == 1.0f && dst.x == floorf(dst.x) && dst.y == floorf(dst.y) && src.x == floorf(src.x) && src.y == floorf(src.y);
+    if(aligned || filter == FILTER_NEAREST || filter == FILTER_NEAREST_MIPMAP_NEAREST || filter == FILTER_NEAREST_MIPMAP_LINEAR){
+        filter = FILTER_NEAREST;
+    }
+
+    int count = x1 - x0;
+    uint32_t *source = GetRow(renderer,count);
+
+    for(int y=y0; y<y1; ++y){
+        float v = src.y + (y + 0.5f - dst.y) * scale_y;
+
+        if(aligned && src.x >= 0.0f && src.x + src.w <= texture->width && v >= 0.0f && v < texture->height){
+            int u = (int)src.x + (x0 - (int)dst.x);
+            WriteSpan(target,target->pixels + y * target->width + x0,texture->pixels + (int)v * texture->width + u,count);
+            continue;
+        }
+
+        for(int x=x0; x<x1; ++x){
+            float u = src.x + (x + 0.5f - dst.x) * scale_x;
+            source[x - x0] = filter == FILTER_NEAREST ? SampleNearest(texture,u,v) : SampleLinear(texture,u,v);
+        }
+        WriteSpan(target,target->pixels + y * target->width + x0,source,count);
+    }
+}
+
+void BlitEx(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect,float angle,Vector2 *center,FlipFlag flags){
+    Rect src = src_rect != NULL ? *src_rect : (Rect){0.0f,0.0f,texture->width,texture->height};
+    Rect dst = dst_rect != NULL ? *dst_rect : (Rect){0.0f,0.0f,src.w,src.h};
+    Vector2 pivot = center != NULL ? *center : (Vector2){dst.w * 0.5f,dst.h * 0.5f};
+
+    float u0 = src.x / texture->width;
+    float v0 = src.y / texture->height;
+    float u1 = (src.x + src.w) / texture->width;
+    float v1 = (src.y + src.h) / texture->height;
+    if(flags & FLIP_HORIZONTAL){float u = u0; u0 = u1; u1 = u;}
+    if(flags & FLIP_VERTICAL){float v = v0; v0 = v1; v1 = v;}
+
+    float radians = angle * (float)M_PI / 180.0f;
+    float c = cosf(radians);
+    float s = sinf(radians);
+    Vector2 corners[4] = {{0.0f,0.0f},{dst.w,0.0f},{dst.w,dst.h},{0.0f,dst.h}};
+    Vector2 texcoords[4] = {{u0,v0},{u1,v0},{u1,v1},{u0,v1}};
+
+    Vertex vertices[4];
+    for(int i=0; i<4; ++i){
+        float x = corners[i].x - pivot.x;
+        float y = corners[i].y - pivot.y;
+        vertices[i].position = (Vector2){dst.x + pivot.x + x * c - y * s,dst.y + pivot.y + x * s + y * c};
+        vertices[i].color = (Color){255,255,255,255};
+        vertices[i].texcoord = texcoords[i];
+    }
+
+    unsigned int indices[6] = {0,1,2,0,2,3};
+    Geometry(renderer,texture,vertices,4,indices,6);
+}
+
+
+//text needs a font rasterizer, which this backend does not have, so fonts never open
+
+bool GlyphIsProvided(Font *font,int char_code){
+    return false;
+}
+
+void GlyphMetrics(Font *font,int char_code,int *advance,int *minx,int *maxx,int *miny,int *maxy){
+    if(advance != NULL) *advance = 0;
+    if(minx != NULL) *minx = 0;
+    if(maxx != NULL) *maxx = 0;
+    if(miny != NULL) *miny = 0;
+    if(maxy != NULL) *maxy = 0;
+}
+
+void SetFontKerning(Font *font,bool allowed){
+}
+
+void SetFontHeight(Font *font,int height){
+}
+
+Font* OpenFont(const char *fileName,int height){
+    return NULL;
+}
+
+void CloseFont(Font *font){
+}
+
+void SizeText(Font *font,const uint16_t *text,int *width,int *height){
+    if(width != NULL) *width = 0;
+    if(height != NULL) *height = 0;
+}
+
+Texture* RenderGlyph(Renderer *renderer,Font *font,uint16_t char_code,Color color){
+    return NULL;
+}
+
+Texture* RenderText(Renderer *renderer,Font *font,const uint16_t *text,Color color){
+    return NULL;
+}
+
+Texture* RenderTextMono(Renderer *renderer,Font *font,const uint16_t *text,Color color){
+    return NULL;
+}
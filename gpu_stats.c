@@ -0,0 +1,305 @@
+#define GPU_STATS_IMPLEMENTATION
+#include "gpu_stats.h"
+
+//a bind is counted whenever a draw uses another texture than the draw before it, NULL for untextured draws
+//a quad is 4 vertices and 6 indices, a polygon outline is counted as a list of lines
+
+static GPUStats frame_stats;
+static GPUStats last_stats;
+static Texture *bound_texture;
+static Texture *current_target;
+
+//overdraw counts every fragment drawn to the screen into a counter per pixel, on the cpu
+//textured draws only count the texels with some alpha, sampled from a copy of the alpha of each texture
+typedef struct _AlphaMask{
+    Texture *texture;
+    int width;
+    int height;
+    uint8_t *alpha;
+}AlphaMask;
+
+static bool overdraw;
+static uint16_t *overdraw_counts;
+static int overdraw_width;
+static int overdraw_height;
+static Texture *overdraw_texture;
+static AlphaMask masks[OVERDRAW_MASKS];
+static int mask_count;
+
+static bool screen_clipping;
+static Rect screen_clip;
+
+static const Color overdraw_colors[OVERDRAW_COLORS] = {
+    {0,0,0,255},{20,40,160,255},{0,150,60,255},{200,200,0,255},
+    {230,120,0,255},{220,0,0,255},{255,0,255,255},{255,255,255,255}
+};
+
+bool GPUStatsEnabled(){
+#ifdef GPU_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+//the counts of the last frame that reached Flip
+GPUStats GetGPUStats(){
+    return last_stats;
+}
+
+//the counts of the frame being drawn
+GPUStats GetFrameGPUStats(){
+    return frame_stats;
+}
+
+static void StatsBind(Texture *texture){
+    if(texture != bound_texture){
+        bound_texture = texture;
+        frame_stats.binds++;
+    }
+}
+
+//the alpha of a texture is read once per frame, pending draws into it are flushed first
+static AlphaMask* GetAlphaMask(Renderer *renderer,Texture *texture){
+    for(int i=0; i<mask_count; ++i){
+        if(masks[i].texture == texture) return &masks[i];
+    }
+    if(mask_count == OVERDRAW_MASKS) return NULL;
+
+    AlphaMask *mask = &masks[mask_count++];
+    mask->texture = texture;
+    TextureSize(texture,&mask->width,&mask->height);
+    mask->alpha = realloc(mask->alpha,(size_t)mask->width * mask->height);
+
+    void *pixels;
+    int pitch;
+    FlushBlitBuffer(renderer);
+    LockTexture(texture,NULL,&pixels,&pitch);
+    for(int y=0; y<mask->height; ++y){
+        Color *row = (Color*)((uint8_t*)pixels + y * pitch);
+        for(int x=0; x<mask->width; ++x){
+            mask->alpha[y * mask->width + x] = row[x].a;
+        }
+    }
+    UnlockTexture(texture);
+    return mask;
+}
+
+static bool SampleAlpha(AlphaMask *mask,float u,float v){
+    if(mask == NULL) return true;
+    int x = (int)u;
+    int y = (int)v;
+    if(x < 0) x = 0;
+    else if(x >= mask->width) x = mask->width - 1;
+    if(y < 0) y = 0;
+    else if(y >= mask->height) y = mask->height - 1;
+    return mask->alpha[y * mask->width + x] > 0;
+}
+
+//the pixels of the screen a draw can reach, inside the window and the clip
+static bool OverdrawBounds(float x0,float y0,float x1,float y1,int *bounds){
+    if(screen_clipping){
+        x0 = fmaxf(x0,screen_clip.x);
+        y0 = fmaxf(y0,screen_clip.y);
+        x1 = fminf(x1,screen_clip.x + screen_clip.w);
+        y1 = fminf(y1,screen_clip.y + screen_clip.h);
+    }
+    bounds[0] = (int)fmaxf(floorf(x0),0.0f);
+    bounds[1] = (int)fmaxf(floorf(y0),0.0f);
+    bounds[2] = (int)fminf(ceilf(x1),overdraw_width);
+    bounds[3] = (int)fminf(ceilf(y1),overdraw_height);
+    return bounds[0] < bounds[2] && bounds[1] < bounds[3];
+}
+
+//pixel centers inside the destination rect, rotation and flips are ignored
+static void OverdrawQuad(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect){
+    if(!overdraw || current_target != NULL) return;
+
+    AlphaMask *mask = (texture != NULL) ? GetAlphaMask(renderer,texture) : NULL;
+    Rect dst = (dst_rect != NULL) ? *dst_rect : (Rect){0.0f,0.0f,overdraw_width,overdraw_height};
+    Rect src = (src_rect != NULL) ? *src_rect : (Rect){0.0f,0.0f,mask ? mask->width : 0,mask ? mask->height : 0};
+    if(dst.w <= 0.0f || dst.h <= 0.0f) return;
+
+    int bounds[4];
+    if(!OverdrawBounds(dst.x,dst.y,dst.x + dst.w,dst.y + dst.h,bounds)) return;
+
+    for(int y=bounds[1]; y<bounds[3]; ++y){
+        float py = y + 0.5f;
+        if(py < dst.y || py >= dst.y + dst.h) continue;
+        float v = src.y + (py - dst.y) * src.h / dst.h;
+        for(int x=bounds[0]; x<bounds[2]; ++x){
+            float px = x + 0.5f;
+            if(px < dst.x || px >= dst.x + dst.w) continue;
+            if(SampleAlpha(mask,src.x + (px - dst.x) * src.w / dst.w,v)) overdraw_counts[y * overdraw_width + x]++;
+        }
+    }
+}
+
+static float Edge(Vector2 a,Vector2 b,float x,float y){
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+//pixel centers inside the triangle, either winding, the texture coordinates are interpolated for the alpha
+static void OverdrawTriangle(AlphaMask *mask,Vertex *a,Vertex *b,Vertex *c){
+    float area = Edge(a->position,b->position,c->position.x,c->position.y);
+    if(area == 0.0f) return;
+
+    int bounds[4];
+    if(!OverdrawBounds(fminf(a->position.x,fminf(b->position.x,c->position.x)),fminf(a->position.y,fminf(b->position.y,c->position.y)),
+                       fmaxf(a->position.x,fmaxf(b->position.x,c->position.x)),fmaxf(a->position.y,fmaxf(b->position.y,c->position.y)),bounds)) return;
+
+    for(int y=bounds[1]; y<bounds[3]; ++y){
+        for(int x=bounds[0]; x<bounds[2]; ++x){
+            float wa = Edge(b->position,c->position,x + 0.5f,y + 0.5f) / area;
+            float wb = Edge(c->position,a->position,x + 0.5f,y + 0.5f) / area;
+            float wc = 1.0f - wa - wb;
+            if(wa < 0.0f || wb < 0.0f || wc < 0.0f) continue;
+
+            if(mask != NULL){
+                float u = (wa * a->texcoord.x + wb * b->texcoord.x + wc * c->texcoord.x) * mask->width;
+                float v = (wa * a->texcoord.y + wb * b->texcoord.y + wc * c->texcoord.y) * mask->height;
+                if(!SampleAlpha(mask,u,v)) continue;
+            }
+            overdraw_counts[y * overdraw_width + x]++;
+        }
+    }
+}
+
+void OverdrawBegin(int width,int height){
+    if(width != overdraw_width || height != overdraw_height){
+        overdraw_counts = realloc(overdraw_counts,sizeof(uint16_t) * width * height);
+        overdraw_width = width;
+        overdraw_height = height;
+    }
+    memset(overdraw_counts,0,sizeof(uint16_t) * width * height);
+    mask_count = 0;
+    overdraw = true;
+}
+
+//stops counting, draws the heatmap over the screen and returns the fragments per covered pixel
+float OverdrawEnd(Renderer *renderer){
+    overdraw = false;
+
+    if(overdraw_texture != NULL){
+        int width,height;
+        TextureSize(overdraw_texture,&width,&height);
+        if(width != overdraw_width || height != overdraw_height){
+            TextureFree(overdraw_texture);
+            overdraw_texture = NULL;
+        }
+    }
+    if(overdraw_texture == NULL){
+        overdraw_texture = CreateTexture(renderer,overdraw_width,overdraw_height,PIXEL_FORMAT_RGBA,false,false);
+        SetTextureFilter(overdraw_texture,FILTER_NEAREST,FILTER_NEAREST);
+    }
+
+    uint64_t fragments = 0;
+    uint64_t covered = 0;
+    void *pixels;
+    int pitch;
+    LockTexture(overdraw_texture,NULL,&pixels,&pitch);
+    for(int y=0; y<overdraw_height; ++y){
+        Color *row = (Color*)((uint8_t*)pixels + y * pitch);
+        for(int x=0; x<overdraw_width; ++x){
+            int count = overdraw_counts[y * overdraw_width + x];
+            fragments += count;
+            if(count > 0) covered++;
+            row[x] = overdraw_colors[count < OVERDRAW_COLORS ? count : OVERDRAW_COLORS - 1];
+        }
+    }
+    UnlockTexture(overdraw_texture);
+
+    Blit(renderer,overdraw_texture,NULL,&(Rect){0.0f,0.0f,overdraw_width,overdraw_height});
+    return covered ? (float)fragments / covered : 0.0f;
+}
+
+void StatsBlit(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect){
+    OverdrawQuad(renderer,texture,src_rect,dst_rect);
+    StatsBind(texture);
+    frame_stats.blits++;
+    frame_stats.vertices += 4;
+    frame_stats.indices += 6;
+    Blit(renderer,texture,src_rect,dst_rect);
+}
+
+void StatsBlitEx(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect,float angle,Vector2 *center,FlipFlag flags){
+    OverdrawQuad(renderer,texture,src_rect,dst_rect);
+    StatsBind(texture);
+    frame_stats.blits++;
+    frame_stats.vertices += 4;
+    frame_stats.indices += 6;
+    BlitEx(renderer,texture,src_rect,dst_rect,angle,center,flags);
+}
+
+void StatsGeometry(Renderer *renderer,Texture *texture,Vertex *vertices,unsigned int vertices_count,unsigned *indices,unsigned int indices_count){
+    if(overdraw && current_target == NULL){
+        AlphaMask *mask = (texture != NULL) ? GetAlphaMask(renderer,texture) : NULL;
+        unsigned int count = indices ? indices_count : vertices_count;
+        for(unsigned int i=0; i+2<count; i+=3){
+            if(indices) OverdrawTriangle(mask,&vertices[indices[i]],&vertices[indices[i + 1]],&vertices[indices[i + 2]]);
+            else OverdrawTriangle(mask,&vertices[i],&vertices[i + 1],&vertices[i + 2]);
+        }
+    }
+    StatsBind(texture);
+    frame_stats.geometries++;
+    frame_stats.vertices += vertices_count;
+    frame_stats.indices += indices ? indices_count : vertices_count;
+    Geometry(renderer,texture,vertices,vertices_count,indices,indices_count);
+}
+
+//polygon outlines are left out of the overdraw, they are a pixel wide
+void StatsDrawFilledPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color){
+    if(overdraw && current_target == NULL){
+        for(unsigned int i=1; i+1<vertices_count; ++i){
+            OverdrawTriangle(NULL,&(Vertex){vertices[0]},&(Vertex){vertices[i]},&(Vertex){vertices[i + 1]});
+        }
+    }
+    StatsBind(NULL);
+    frame_stats.polygons++;
+    frame_stats.vertices += vertices_count;
+    if(vertices_count >= 3) frame_stats.indices += (vertices_count - 2) * 3;
+    DrawFilledPolygon(renderer,vertices,vertices_count,color);
+}
+
+void StatsDrawPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color){
+    StatsBind(NULL);
+    frame_stats.polygons++;
+    frame_stats.vertices += vertices_count;
+    frame_stats.indices += vertices_count * 2;
+    DrawPolygon(renderer,vertices,vertices_count,color);
+}
+
+void StatsRendererSetTarget(Renderer *renderer,Texture *target){
+    if(target != current_target){
+        current_target = target;
+        frame_stats.targets++;
+    }
+    RendererSetTarget(renderer,target);
+}
+
+void StatsSetClip(Renderer *renderer,Texture *target,Rect *rect){
+    if(target == NULL){
+        screen_clipping = true;
+        screen_clip = *rect;
+    }
+    SetClip(renderer,target,rect);
+}
+
+void StatsUnSetClip(Renderer *renderer,Texture *target){
+    if(target == NULL) screen_clipping = false;
+    UnSetClip(renderer,target);
+}
+
+void StatsFlushBlitBuffer(Renderer *renderer){
+    frame_stats.flushes++;
+    FlushBlitBuffer(renderer);
+}
+
+//Flip submits the frame, so it is also where one frame's counts end and the next begin
+void StatsFlip(Renderer *renderer){
+    frame_stats.flushes++;
+    Flip(renderer);
+    last_stats = frame_stats;
+    frame_stats = (GPUStats){0};
+    bound_texture = NULL;
+}
@@ -0,0 +1,67 @@
+#ifndef GPU_STATS_H_
+#define GPU_STATS_H_
+
+#include <GPU.h>
+
+//building with -DGPU_STATS routes the drawing entry points of GPU.h through counting wrappers
+//gpu_stats.c itself calls the real functions, so it is compiled without the redirection
+
+#define OVERDRAW_MASKS 8
+#define OVERDRAW_COLORS 8
+
+typedef struct _GPUStats{
+    uint64_t blits;
+    uint64_t geometries;
+    uint64_t polygons;
+    uint64_t flushes;
+    uint64_t vertices;
+    uint64_t indices;
+    uint64_t binds;
+    uint64_t targets;
+}GPUStats;
+
+
+bool GPUStatsEnabled();
+
+GPUStats GetGPUStats();
+
+GPUStats GetFrameGPUStats();
+
+void OverdrawBegin(int width,int height);
+
+float OverdrawEnd(Renderer *renderer);
+
+void StatsBlit(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect);
+
+void StatsBlitEx(Renderer *renderer,Texture *texture,Rect *src_rect,Rect *dst_rect,float angle,Vector2 *center,FlipFlag flags);
+
+void StatsGeometry(Renderer *renderer,Texture *texture,Vertex *vertices,unsigned int vertices_count,unsigned *indices,unsigned int indices_count);
+
+void StatsDrawFilledPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color);
+
+void StatsDrawPolygon(Renderer *renderer,Vector2 *vertices,unsigned int vertices_count,Color color);
+
+void StatsRendererSetTarget(Renderer *renderer,Texture *target);
+
+void StatsSetClip(Renderer *renderer,Texture *target,Rect *rect);
+
+void StatsUnSetClip(Renderer *renderer,Texture *target);
+
+void StatsFlushBlitBuffer(Renderer *renderer);
+
+void StatsFlip(Renderer *renderer);
+
+#if defined(GPU_STATS) && !defined(GPU_STATS_IMPLEMENTATION)
+#define Blit StatsBlit
+#define BlitEx StatsBlitEx
+#define Geometry StatsGeometry
+#define DrawFilledPolygon StatsDrawFilledPolygon
+#define DrawPolygon StatsDrawPolygon
+#define RendererSetTarget StatsRendererSetTarget
+#define SetClip StatsSetClip
+#define UnSetClip StatsUnSetClip
+#define FlushBlitBuffer StatsFlushBlitBuffer
+#define Flip StatsFlip
+#endif
+
+#endif
@@ -0,0 +1,156 @@
+#include "hud.h"
+
+//each glyph is rendered to its own texture once, packed in rows into the hud texture and freed,
+//the text is drawn white into it and tinted by the vertex color
+
+static void BuildGlyphAtlas(Hud *hud,Renderer *renderer){
+    Texture *textures[HUD_GLYPHS] = {NULL};
+    int x = 0,y = 0,row = 0;
+
+    for(int i=0; i<HUD_GLYPHS; ++i){
+        int char_code = HUD_FIRST_GLYPH + i;
+        Glyph *glyph = &hud->glyphs[i];
+        glyph->provided = false;
+        glyph->advance = 0;
+        if(!GlyphIsProvided(hud->font,char_code)) continue;
+
+        GlyphMetrics(hud->font,char_code,&glyph->advance,NULL,NULL,NULL,NULL);
+        textures[i] = RenderGlyph(renderer,hud->font,char_code,(Color){255,255,255,255});
+        if(textures[i] == NULL) continue;
+
+        int w,h;
+        TextureSize(textures[i],&w,&h);
+        if(x + w + HUD_PADDING > HUD_ATLAS_WIDTH){
+            x = 0;
+            y += row;
+            row = 0;
+        }
+        glyph->rect = (Rect){x,y,w,h};
+        glyph->provided = true;
+        x += w + HUD_PADDING;
+        if(h + HUD_PADDING > row) row = h + HUD_PADDING;
+        if(h > hud->line_height) hud->line_height = h;
+    }
+
+    hud->width = HUD_ATLAS_WIDTH;
+    hud->height = (y + row > 0) ? y + row : 1;
+    hud->texture = CreateTexture(renderer,hud->width,hud->height,PIXEL_FORMAT_RGBA,false,true);
+    SetTextureFilter(hud->texture,FILTER_NEAREST,FILTER_NEAREST);
+
+    //the glyph pixels are copied as they are, alpha included, over a transparent texture
+    Texture *target = hud->state->target;
+    FlushBlitBuffer(renderer);
+    StateSetTarget(hud->state,hud->texture);
+    ClearRGBA(renderer,0,0,0,0);
+    StateSetBlendMode(hud->state,hud->texture,BLEND_SET);
+    for(int i=0; i<HUD_GLYPHS; ++i){
+        if(textures[i] == NULL) continue;
+        Rect rect = hud->glyphs[i].rect;
+        Blit(renderer,textures[i],NULL,&rect);
+    }
+    FlushBlitBuffer(renderer);
+    StateSetBlendMode(hud->state,hud->texture,BLEND_NORMAL);
+    StateSetTarget(hud->state,target);
+
+    for(int i=0; i<HUD_GLYPHS; ++i){
+        if(textures[i] != NULL) TextureFree(textures[i]);
+    }
+}
+
+//NULL when the font can't be opened, the game runs without a hud then
+Hud* CreateHud(RenderState *state,const char *font_path,int height){
+    if(font_path == NULL) return NULL;
+    Font *font = OpenFont(font_path,height);
+    if(font == NULL) return NULL;
+
+    Hud *hud = malloc(sizeof(Hud));
+    hud->state = state;
+    hud->font = font;
+    hud->line_height = 0;
+    BuildGlyphAtlas(hud,state->renderer);
+
+    hud->text[0] = '\0';
+    hud->position = (Vector2){0.0f,0.0f};
+    hud->color = (Color){0,0,0,0};
+    hud->count = 0;
+
+    for(int i=0; i<HUD_TEXT; ++i){
+        unsigned int first = i * 4;
+        unsigned int *index = hud->indices + i * 6;
+        index[0] = first;
+        index[1] = first + 1;
+        index[2] = first + 2;
+        index[3] = first;
+        index[4] = first + 2;
+        index[5] = first + 3;
+    }
+
+    hud->layouts = 0;
+    hud->unchanged = 0;
+
+    return hud;
+}
+
+void HudFree(Hud *hud){
+    StateForget(hud->state,hud->texture);
+    TextureFree(hud->texture);
+    CloseFont(hud->font);
+    free(hud);
+}
+
+static void HudLayout(Hud *hud){
+    float pen_x = hud->position.x;
+    float pen_y = hud->position.y;
+    Vertex *vertex = hud->vertices;
+    hud->count = 0;
+
+    for(const char *c = hud->text; *c != '\0'; ++c){
+        if(*c == '\n'){
+            pen_x = hud->position.x;
+            pen_y += hud->line_height;
+            continue;
+        }
+        if(*c < HUD_FIRST_GLYPH || *c > HUD_LAST_GLYPH) continue;
+
+        Glyph *glyph = &hud->glyphs[*c - HUD_FIRST_GLYPH];
+        if(!glyph->provided) continue;
+
+        Rect rect = glyph->rect;
+        float u0 = rect.x / hud->width;
+        float v0 = rect.y / hud->height;
+        float u1 = (rect.x + rect.w) / hud->width;
+        float v1 = (rect.y + rect.h) / hud->height;
+
+        vertex[0] = (Vertex){{pen_x,pen_y},hud->color,{u0,v0}};
+        vertex[1] = (Vertex){{pen_x + rect.w,pen_y},hud->color,{u1,v0}};
+        vertex[2] = (Vertex){{pen_x + rect.w,pen_y + rect.h},hud->color,{u1,v1}};
+        vertex[3] = (Vertex){{pen_x,pen_y + rect.h},hud->color,{u0,v1}};
+        vertex += 4;
+        hud->count++;
+
+        pen_x += (glyph->advance > 0) ? glyph->advance : rect.w;
+    }
+
+    hud->layouts++;
+}
+
+//the same text at the same place keeps the quads from the last layout
+void HudSetText(Hud *hud,const char *text,Vector2 position,Color color){
+    position.x = floorf(position.x);
+    position.y = floorf(position.y);
+
+    if(strcmp(hud->text,text) == 0 && hud->position.x == position.x && hud->position.y == position.y &&
+        hud->color.r == color.r && hud->color.g == color.g && hud->color.b == color.b && hud->color.a == color.a){
+        hud->unchanged++;
+        return;
+    }
+
+    snprintf(hud->text,sizeof(hud->text),"%s",text);
+    hud->position = position;
+    hud->color = color;
+    HudLayout(hud);
+}
+
+void DrawHud(Renderer *renderer,Hud *hud){
+    if(hud->count > 0) Geometry(renderer,hud->texture,hud->vertices,hud->count * 4,hud->indices,hud->count * 6);
+}
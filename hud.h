@@ -0,0 +1,52 @@
+#ifndef HUD_H_
+#define HUD_H_
+
+#include "state.h"
+
+#define HUD_FIRST_GLYPH 32
+#define HUD_LAST_GLYPH 126
+#define HUD_GLYPHS (HUD_LAST_GLYPH - HUD_FIRST_GLYPH + 1)
+#define HUD_ATLAS_WIDTH 512
+#define HUD_PADDING 1
+#define HUD_TEXT 256
+#define HUD_FONT_HEIGHT 16
+#define HUD_MARGIN 10
+
+typedef struct _Glyph{
+    Rect rect;
+    int advance;
+    bool provided;
+}Glyph;
+
+//the printable ascii glyphs are rasterized once into one texture,
+//the text is kept as quads into it and laid out again only when it changes
+typedef struct _Hud{
+    RenderState *state;
+    Font *font;
+    Texture *texture;
+    int width;
+    int height;
+    int line_height;
+    Glyph glyphs[HUD_GLYPHS];
+
+    char text[HUD_TEXT];
+    Vector2 position;
+    Color color;
+    Vertex vertices[HUD_TEXT * 4];
+    unsigned int indices[HUD_TEXT * 6];
+    int count;
+
+    uint64_t layouts;
+    uint64_t unchanged;
+}Hud;
+
+
+Hud* CreateHud(RenderState *state,const char *font_path,int height);
+
+void HudFree(Hud *hud);
+
+void HudSetText(Hud *hud,const char *text,Vector2 position,Color color);
+
+void DrawHud(Renderer *renderer,Hud *hud);
+
+#endif
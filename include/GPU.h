@@ -1,7 +1,11 @@
 #ifndef GPU_H_
 #define GPU_H_
 
+#ifdef _WIN32
 #define DLLExport __declspec(dllexport)
+#else
+#define DLLExport
+#endif
 
 #include <SDL2/SDL.h>
 
@@ -12,6 +16,7 @@
 #include <errno.h>
 #include <math.h>
 
+#ifdef _WIN32
 typedef signed char      int8_t;
 typedef signed short     int16_t;
 typedef signed int       int32_t;
@@ -21,6 +26,9 @@ typedef unsigned char      uint8_t;
 typedef unsigned short     uint16_t;
 typedef unsigned int       uint32_t;
 typedef unsigned long long uint64_t;
+#else
+#include <stdint.h>
+#endif
 
 typedef struct _Font     Font;
 typedef struct _Texture  Texture;
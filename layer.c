@@ -0,0 +1,220 @@
+#include "layer.h"
+
+//the layer holds every piece that is resting on a cell, that is the whole body but the head and the tail,
+//which are the only pieces that slide between cells and are drawn on top of it every frame
+
+SnakeLayer* CreateSnakeLayer(Renderer *renderer){
+    int width = (columns + rows) * TILE_SIZE;
+    int height = (columns + rows) * TILE_SIZE / 2 + BLOCK_SIZE;
+    if(width > LAYER_MAX_SIZE || height > LAYER_MAX_SIZE) return NULL;
+
+    SnakeLayer *layer = malloc(sizeof(SnakeLayer));
+    layer->texture = CreateTexture(renderer,width,height,PIXEL_FORMAT_RGBA,false,true);
+    layer->offset = (Vector2){(rows - 1) * TILE_SIZE,0.0f};
+    layer->counts = calloc(columns * rows,sizeof(int));
+    layer->touched = calloc(columns * rows,sizeof(uint8_t));
+    layer->cells = malloc(sizeof(int) * STEP_LOG * 2);
+
+    layer->steps = 0;
+    layer->valid = false;
+
+    layer->updates = 0;
+    layer->rebuilds = 0;
+
+    return layer;
+}
+
+void SnakeLayerFree(SnakeLayer *layer){
+    TextureFree(layer->texture);
+    free(layer->counts);
+    free(layer->touched);
+    free(layer->cells);
+    free(layer);
+}
+
+static Rect GetLayerRect(SnakeLayer *layer,int x,int y){
+    Vector2 position = GetIsometricPosition(x * TILE_SIZE,y * TILE_SIZE);
+    return (Rect){position.x + layer->offset.x,position.y + layer->offset.y,BLOCK_SIZE,BLOCK_SIZE};
+}
+
+//redraws the area of one cell sprite from the cells whose sprites overlap it, back to front
+//in isometric space u = x - y and v = x + y, sprites overlap when |du| <= 1 and |dv| <= 3
+static void RecomposeCell(SnakeLayer *layer,Renderer *renderer,int cell,Rect *sprite,Atlas *atlas){
+    int x = cell % columns;
+    int y = cell / columns;
+    Rect rect = GetLayerRect(layer,x,y);
+
+    StateSetClip(atlas->state,layer->texture,&rect);
+    ClearRGBA(renderer,0,0,0,0);
+
+    for(int dv=-3; dv<=3; ++dv){
+        for(int du=-1; du<=1; ++du){
+            if((du + dv) % 2 != 0) continue;
+
+            int nx = x + (du + dv) / 2;
+            int ny = y + (dv - du) / 2;
+            if(nx < 0 || ny < 0 || nx >= columns || ny >= rows) continue;
+            if(layer->counts[ny * columns + nx] == 0) continue;
+
+            Rect dst = GetLayerRect(layer,nx,ny);
+            Blit(renderer,atlas->texture,sprite,&dst);
+        }
+    }
+
+    StateUnSetClip(atlas->state,layer->texture);
+}
+
+static bool IsMoving(Piece *piece,Snake *snake){
+    return piece == snake->head || piece == snake->tail;
+}
+
+void SnakeLayerRebuild(SnakeLayer *layer,Renderer *renderer,Snake *snake,Atlas *atlas){
+    Rect sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_PIECE]);
+
+    memset(layer->counts,0,sizeof(int) * columns * rows);
+    for(Piece *piece = snake->body; piece != NULL; piece = piece->next){
+        if(!IsMoving(piece,snake)) layer->counts[GetCell(piece->current_position)]++;
+    }
+
+    Texture *target = atlas->state->target;
+    StateSetTarget(atlas->state,layer->texture);
+    ClearRGBA(renderer,0,0,0,0);
+
+    //walking the diagonals x + y in increasing order draws the cells back to front
+    for(int v=0; v<columns+rows-1; ++v){
+        for(int x=(v < rows ? 0 : v - rows + 1); x<=v && x<columns; ++x){
+            if(layer->counts[(v - x) * columns + x] == 0) continue;
+            Rect dst = GetLayerRect(layer,x,v - x);
+            Blit(renderer,atlas->texture,&sprite,&dst);
+        }
+    }
+
+    StateSetTarget(atlas->state,target);
+
+    layer->steps = snake->steps;
+    layer->valid = true;
+    layer->rebuilds++;
+}
+
+static void TouchCell(SnakeLayer *layer,int cell,int *count){
+    if(layer->touched[cell]) return;
+    layer->touched[cell] = 1;
+    layer->cells[(*count)++] = cell;
+}
+
+//a step turns the old head into a resting piece and, unless the snake grew, lifts the piece in front of the tail off its cell,
+//the steps since the last update are replayed from the snake's log and each touched cell is redrawn once with the sprites overlapping it
+void SnakeLayerUpdate(SnakeLayer *layer,Renderer *renderer,Snake *snake,Atlas *atlas){
+    if(layer->valid && layer->steps == snake->steps) return;
+
+    if(!layer->valid || snake->steps - layer->steps > STEP_LOG){
+        SnakeLayerRebuild(layer,renderer,snake,atlas);
+        return;
+    }
+
+    int count = 0;
+    for(uint64_t step = layer->steps + 1; step <= snake->steps; ++step){
+        StepChange *change = &snake->changes[step % STEP_LOG];
+        layer->counts[change->entered]++;
+        TouchCell(layer,change->entered,&count);
+        if(!change->grew){
+            layer->counts[change->tail]--;
+            TouchCell(layer,change->tail,&count);
+        }
+    }
+
+    Rect sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_PIECE]);
+    Texture *target = atlas->state->target;
+    StateSetTarget(atlas->state,layer->texture);
+
+    for(int i=0; i<count; ++i){
+        RecomposeCell(layer,renderer,layer->cells[i],&sprite,atlas);
+        layer->touched[layer->cells[i]] = 0;
+    }
+
+    StateSetTarget(atlas->state,target);
+
+    layer->steps = snake->steps;
+    layer->updates++;
+}
+
+static void SortDepthItems(DepthItem *items,int count){
+    for(int i=1; i<count; ++i){
+        DepthItem item = items[i];
+        int j = i - 1;
+        while(j >= 0 && items[j].depth > item.depth){
+            items[j + 1] = items[j];
+            --j;
+        }
+        items[j + 1] = item;
+    }
+}
+
+static bool RectOverlap(Rect *a,Rect *b){
+    return a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+//draws the layer, then the tail, the head and the food back to front on top of it
+//resting pieces in front of one of them are drawn again clipped to its rect, so every overlap follows depth
+void DrawSnakeLayer(Renderer *renderer,SnakeLayer *layer,Snake *snake,Vector2 *point,Camera *camera,Atlas *atlas){
+    int width,height;
+    TextureSize(layer->texture,&width,&height);
+    Blit(renderer,layer->texture,NULL,&(Rect){
+        camera->translate.x - layer->offset.x * camera->scale,
+        camera->translate.y - layer->offset.y * camera->scale,
+        width * camera->scale,
+        height * camera->scale
+    });
+
+    Rect piece_sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_PIECE]);
+    Rect point_sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_POINT]);
+
+    //sort keys are depth * 4 plus a rank, on the same diagonal resting pieces go first, then tail, head and food
+    //the depth of a piece sliding across the wrap is negative, so the position is found by index and not by the rank
+    Vector2 positions[3] = {snake->tail->current_position,snake->head->current_position,*point};
+    DepthItem dynamic[3];
+    for(int i=0; i<3; ++i){
+        Rect dst = GetScreenRect(camera,positions[i],0.0f);
+        dynamic[i] = (DepthItem){i == 2 ? point_sprite : piece_sprite,dst,GetDepth(positions[i]) * 4 + i + 1,i};
+    }
+    SortDepthItems(dynamic,3);
+
+    for(int i=0; i<3; ++i){
+        Blit(renderer,atlas->texture,&dynamic[i].src,&dynamic[i].dst);
+    }
+
+    DepthItem front[48];
+    for(int i=0; i<3; ++i){
+        Vector2 position = positions[dynamic[i].index];
+        int cx = (int)floorf(position.x / TILE_SIZE);
+        int cy = (int)floorf(position.y / TILE_SIZE);
+        int count = 0;
+
+        //sprites overlap within two cells along x - y and four along x + y
+        for(int y=cy-2; y<=cy+3; ++y){
+            for(int x=cx-2; x<=cx+3; ++x){
+                if(x < 0 || y < 0 || x >= columns || y >= rows) continue;
+                if(layer->counts[y * columns + x] == 0) continue;
+
+                int depth = (x + y) * 2 * 4;
+                if(depth < dynamic[i].depth) continue;
+
+                Rect dst = GetScreenRect(camera,(Vector2){x * TILE_SIZE,y * TILE_SIZE},0.0f);
+                if(RectOverlap(&dst,&dynamic[i].dst)) front[count++] = (DepthItem){piece_sprite,dst,depth,-1};
+            }
+        }
+
+        if(count == 0) continue;
+
+        for(int j=i+1; j<3; ++j){
+            if(RectOverlap(&dynamic[j].dst,&dynamic[i].dst)) front[count++] = dynamic[j];
+        }
+        SortDepthItems(front,count);
+
+        StateSetClip(atlas->state,atlas->state->target,&dynamic[i].dst);
+        for(int j=0; j<count; ++j){
+            Blit(renderer,atlas->texture,&front[j].src,&front[j].dst);
+        }
+        StateUnSetClip(atlas->state,atlas->state->target);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef LAYER_H_
+#define LAYER_H_
+
+#include "snake.h"
+
+#define LAYER_MAX_SIZE 8192
+
+typedef struct _SnakeLayer{
+    Texture *texture;
+    Vector2 offset;
+    int *counts;
+    uint8_t *touched;
+    int *cells;
+
+    uint64_t steps;
+    bool valid;
+
+    uint64_t updates;
+    uint64_t rebuilds;
+}SnakeLayer;
+
+
+SnakeLayer* CreateSnakeLayer(Renderer *renderer);
+
+void SnakeLayerFree(SnakeLayer *layer);
+
+void SnakeLayerRebuild(SnakeLayer *layer,Renderer *renderer,Snake *snake,Atlas *atlas);
+
+void SnakeLayerUpdate(SnakeLayer *layer,Renderer *renderer,Snake *snake,Atlas *atlas);
+
+void DrawSnakeLayer(Renderer *renderer,SnakeLayer *layer,Snake *snake,Vector2 *point,Camera *camera,Atlas *atlas);
+
+#endif
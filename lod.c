@@ -0,0 +1,79 @@
+#include "lod.h"
+
+//far from the board a block covers a handful of pixels, so it is drawn as its flat top face,
+//and further out every cell becomes a single texel of the minimap texture stretched over the board
+
+Detail GetDetail(Camera *camera){
+    if(camera->scale >= LOD_BLOCKS_SCALE) return DETAIL_BLOCKS;
+    if(camera->scale >= LOD_DIAMONDS_SCALE) return DETAIL_DIAMONDS;
+    return DETAIL_TEXTURE;
+}
+
+LevelOfDetail* CreateLevelOfDetail(){
+    LevelOfDetail *lod = malloc(sizeof(LevelOfDetail));
+    lod->vertices = NULL;
+    lod->indices = NULL;
+    lod->count = 0;
+    lod->capacity = 0;
+
+    return lod;
+}
+
+void LevelOfDetailFree(LevelOfDetail *lod){
+    free(lod->vertices);
+    free(lod->indices);
+    free(lod);
+}
+
+//the top face of the block whose sprite fills rect
+static void PushDiamond(LevelOfDetail *lod,Rect rect,Color color){
+    if(lod->count == lod->capacity){
+        lod->capacity = lod->capacity ? lod->capacity * 2 : 1024;
+        lod->vertices = realloc(lod->vertices,sizeof(Vertex) * lod->capacity * 4);
+        lod->indices = realloc(lod->indices,sizeof(unsigned int) * lod->capacity * 6);
+    }
+
+    Vertex *vertex = lod->vertices + lod->count * 4;
+    vertex[0] = (Vertex){{rect.x + rect.w * 0.5f,rect.y},color,{0.0f,0.0f}};
+    vertex[1] = (Vertex){{rect.x + rect.w,rect.y + rect.h * 0.25f},color,{0.0f,0.0f}};
+    vertex[2] = (Vertex){{rect.x + rect.w * 0.5f,rect.y + rect.h * 0.5f},color,{0.0f,0.0f}};
+    vertex[3] = (Vertex){{rect.x,rect.y + rect.h * 0.25f},color,{0.0f,0.0f}};
+
+    unsigned int first = lod->count * 4;
+    unsigned int *index = lod->indices + lod->count * 6;
+    index[0] = first;
+    index[1] = first + 1;
+    index[2] = first + 2;
+    index[3] = first;
+    index[4] = first + 2;
+    index[5] = first + 3;
+
+    lod->count++;
+}
+
+//flat diamonds don't overlap, so the floor goes first and the snake and the food on top in any order
+void DrawDiamonds(Renderer *renderer,LevelOfDetail *lod,Snake *snake,Vector2 *point,Camera *camera,Atlas *atlas){
+    CellRange range = GetVisibleCells(camera,TILE_SIZE);
+    Color floor_color = atlas->sprites[SPRITE_FLOOR].fill_color;
+    int x0,x1;
+
+    lod->count = 0;
+    for(int v=range.v0; v<=range.v1; ++v){
+        GetDiagonalCells(&range,v,&x0,&x1);
+        for(int x=x0; x<=x1; ++x){
+            PushDiamond(lod,GetScreenRect(camera,(Vector2){x * TILE_SIZE,(v - x) * TILE_SIZE},TILE_SIZE),floor_color);
+        }
+    }
+
+    Rect rect = GetScreenRect(camera,*point,0.0f);
+    if(RectVisible(camera,&rect)) PushDiamond(lod,rect,atlas->sprites[SPRITE_POINT].fill_color);
+
+    for(Piece *piece = snake->body; piece != NULL; piece = piece->next){
+        rect = GetScreenRect(camera,piece->current_position,0.0f);
+        if(RectVisible(camera,&rect)) PushDiamond(lod,rect,atlas->sprites[SPRITE_PIECE].fill_color);
+    }
+
+    if(lod->count > 0){
+        Geometry(renderer,NULL,lod->vertices,lod->count * 4,lod->indices,lod->count * 6);
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef LOD_H_
+#define LOD_H_
+
+#include "snake.h"
+
+#define LOD_BLOCKS_SCALE 0.5f
+#define LOD_DIAMONDS_SCALE 0.125f
+
+typedef enum _Detail{
+    DETAIL_BLOCKS,
+    DETAIL_DIAMONDS,
+    DETAIL_TEXTURE,
+}Detail;
+
+typedef struct _LevelOfDetail{
+    Vertex *vertices;
+    unsigned int *indices;
+    int count;
+    int capacity;
+}LevelOfDetail;
+
+
+Detail GetDetail(Camera *camera);
+
+LevelOfDetail* CreateLevelOfDetail();
+
+void LevelOfDetailFree(LevelOfDetail *lod);
+
+void DrawDiamonds(Renderer *renderer,LevelOfDetail *lod,Snake *snake,Vector2 *point,Camera *camera,Atlas *atlas);
+
+#endif
@@ -1,296 +1,53 @@
-#include <GPU.h>
-#include <time.h>
-
-#define TILE_SIZE 16
-#define BLOCK_SIZE (TILE_SIZE*2)
-#define COLUMNS 30
-#define ROWS 30
-#define VELOCITY 150
-
-typedef struct _Piece{
-    Vector2 direction;
-    Vector2 current_position;
-    Vector2 next_position;
-    Vector2 previous_position;
-
-    struct _Piece *next;
-    struct _Piece *previous;
-}Piece;
-
-typedef struct _Snake{
-    bool moving;
-    Vector2 buffer_direction;
-    Piece *body;
-    Piece *head;
-    Piece *tail;
-}Snake;
-
-void GetPointPosition(Vector2 *point){
-    point->x = (rand() % COLUMNS) * TILE_SIZE;
-    point->y = (rand() % ROWS) * TILE_SIZE;
-}
-
-Vector2 GetIsometricPosition(float x,float y){
-    return (Vector2){x - y,(y + x) * 0.5f};
-}
-
-Piece* AddPiece(Piece **body,Piece source){
-    Piece *piece = malloc(sizeof(Piece));
-    *piece = source;
-
-    if(*body == NULL){
-        *body = piece;
-        piece->next = NULL;
-        piece->previous = NULL;
-    }
-    else{
-        Piece *buffer = *body;
-        while(buffer->next != NULL){buffer = buffer->next;}
-        buffer->next = piece;
-        piece->previous = buffer;
-        piece->next = NULL;
-    }
-
-    return piece;
-}
-
-Snake* CreateSnake(){
-    
-    Snake *snake = malloc(sizeof(Snake));
-    snake->moving = false;
-    snake->buffer_direction = (Vector2){0.0f,0.0f};
-
-    Piece piece1 = {{0.0f},{2.0f*TILE_SIZE,0.0f},{2.0f*TILE_SIZE,0.0f},{2.0f*TILE_SIZE,0.0f},NULL,NULL};
-    Piece piece2 = {{0.0f},{2.0f*TILE_SIZE,0.0f},{2.0f*TILE_SIZE,0.0f},{2.0f*TILE_SIZE,0.0f},NULL,NULL};
-    Piece piece3 = {{0.0f},{1.0f*TILE_SIZE,0.0f},{1.0f*TILE_SIZE,0.0f},{1.0f*TILE_SIZE,0.0f},NULL,NULL};;
-    Piece piece4 = {{0.0f},{0.0f},{0.0f},{0.0f},NULL,NULL};;
-
-    snake->body = NULL;
-
-    snake->head = AddPiece(&snake->body,piece1);
-
-    AddPiece(&snake->body,piece2);
-    AddPiece(&snake->body,piece3);
-
-    snake->tail = AddPiece(&snake->body,piece4);
-
-    return snake;
-}
+#include "snake.h"
+#include "frame.h"
+#include "layer.h"
+#include "lod.h"
+#include "minimap.h"
+#include "particles.h"
+#include "hud.h"
+#include "debug.h"
 
-void SnakeFree(Snake *snake){
-    Piece *piece = snake->body;
-    Piece *buffer;
-    while(piece != NULL){
-        buffer = piece->next;
-        free(piece);
-        piece = buffer;
-    }
-    free(snake);
-}
-
-void DrawBlock(Renderer *renderer,Vector2 position,Color border_color,Color fill_color){
-
-    Vector2 top_face[4] = {
-        {position.x,position.y},
-        {position.x+TILE_SIZE,position.y-TILE_SIZE*0.5f},
-        {position.x,position.y-TILE_SIZE},
-        {position.x-TILE_SIZE,position.y-TILE_SIZE*0.5f}
-    };
-
-    Vector2 left_face[4] = {
-        {position.x,position.y},
-        {position.x,position.y+TILE_SIZE},
-        {position.x-TILE_SIZE,position.y+TILE_SIZE*0.5f},
-        {position.x-TILE_SIZE,position.y-TILE_SIZE*0.5f}
-    };
-
-    Vector2 right_face[4] = {
-        {position.x,position.y},
-        {position.x+TILE_SIZE,position.y-TILE_SIZE*0.5f},
-        {position.x+TILE_SIZE,position.y+TILE_SIZE*0.5f},
-        {position.x,position.y+TILE_SIZE}
-    };
-
-    DrawFilledPolygon(renderer,top_face,4,fill_color);
-    DrawFilledPolygon(renderer,left_face,4,fill_color);
-    DrawFilledPolygon(renderer,right_face,4,fill_color);
-
-    DrawPolygon(renderer,top_face,4,border_color);
-    DrawPolygon(renderer,left_face,4,border_color);
-    DrawPolygon(renderer,right_face,4,border_color);
-}
-
-void DrawFloor(Renderer *renderer,Vector2 translate,Texture *floor_texture){
-    Vector2 position;
-    for(int y=0; y<ROWS; ++y){
-        for(int x=0; x<COLUMNS; ++x){
-            position = GetIsometricPosition(x * TILE_SIZE,y * TILE_SIZE);
-            position.x += translate.x;
-            position.y += translate.y + TILE_SIZE;
-            Blit(renderer,floor_texture,NULL,&(Rect){position.x,position.y,BLOCK_SIZE,BLOCK_SIZE});
-        }
-    }
-}
-
-void DrawSnake(Renderer *renderer,Snake *snake,Vector2 translate,Texture *piece_texture){
-    Vector2 position;
-    Piece *buffer = snake->body;
-    while(buffer != NULL){
-        position = GetIsometricPosition(buffer->current_position.x,buffer->current_position.y);
-        position.x += translate.x;
-        position.y += translate.y;
-        Blit(renderer,piece_texture,NULL,&(Rect){position.x,position.y,BLOCK_SIZE,BLOCK_SIZE});
-        buffer = buffer->next;
-    }
-}
-
-Vector2 GetTailDirection(Piece *tail){
-    Vector2 direction = {0.0f};
-    if(tail->previous != NULL){
-        direction.x = (tail->previous->current_position.x - tail->current_position.x) / TILE_SIZE;
-        direction.y = (tail->previous->current_position.y - tail->current_position.y) / TILE_SIZE;
-
-        if(direction.x >= (COLUMNS-1)){
-            direction.x = -1.0f;
-        }
-        else if(direction.x <= -(COLUMNS-1)){
-            direction.x = 1.0f;
-        }
+int main(int n_args,char **args){
+    SDL_Init(SDL_INIT_EVERYTHING);
 
-        if(direction.y >= (ROWS-1)){
-            direction.y = -1.0f;
+    bool solver_mode = false;
+    bool latch = false;
+    double fps = 60.0;
+    float zoom = 1.0f;
+    float resolution = MIN_RESOLUTION;
+    double time_scale = 1.0;
+    const char *font_path = NULL;
+    PacingMode pacing = PACING_HYBRID;
+    for(int i=1; i<n_args; ++i){
+        if(strcmp(args[i],"--solver") == 0) solver_mode = true;
+        else if(strcmp(args[i],"--latch") == 0) latch = true;
+        else if(strcmp(args[i],"--speed") == 0 && i+1 < n_args) time_scale = atof(args[++i]);
+        else if(strcmp(args[i],"--fps") == 0 && i+1 < n_args) fps = atof(args[++i]);
+        else if(strcmp(args[i],"--pacing") == 0 && i+1 < n_args){
+            ++i;
+            if(strcmp(args[i],"sleep") == 0) pacing = PACING_SLEEP;
+            else if(strcmp(args[i],"spin") == 0) pacing = PACING_SPIN;
+            else pacing = PACING_HYBRID;
         }
-        else if(direction.y <= -(ROWS-1)){
-            direction.y = 1.0f;
+        else if(strcmp(args[i],"--board") == 0 && i+1 < n_args){
+            //the starting snake needs three cells in a row and the minimap needs one texel per cell
+            int c,r;
+            if(sscanf(args[++i],"%dx%d",&c,&r) == 2 && c >= MIN_COLUMNS && r >= MIN_ROWS && c <= MAX_BOARD_SIZE && r <= MAX_BOARD_SIZE){
+                columns = c;
+                rows = r;
+            }
+            else{
+                fprintf(stderr,"--board expects CxR with %d <= C <= %d and %d <= R <= %d, using %dx%d\n",MIN_COLUMNS,MAX_BOARD_SIZE,MIN_ROWS,MAX_BOARD_SIZE,COLUMNS,ROWS);
+                columns = COLUMNS;
+                rows = ROWS;
+            }
         }
+        else if(strcmp(args[i],"--zoom") == 0 && i+1 < n_args) zoom = atof(args[++i]);
+        else if(strcmp(args[i],"--resolution") == 0 && i+1 < n_args) resolution = atof(args[++i]);
+        else if(strcmp(args[i],"--font") == 0 && i+1 < n_args) font_path = args[++i];
     }
-    return direction;
-}
-
-void SnakeNextMove(Snake *snake){
-
-    if(!snake->buffer_direction.x && !snake->buffer_direction.y){
-        snake->moving = false;
-        return;
-    }
-
-    snake->head->direction = snake->buffer_direction;
-    
-    snake->head->previous_position = snake->head->current_position;
-    
-    snake->head->next_position = (Vector2){
-        snake->head->current_position.x + snake->head->direction.x * TILE_SIZE,
-        snake->head->current_position.y + snake->head->direction.y * TILE_SIZE
-    };
-
-    snake->tail->direction = GetTailDirection(snake->tail);
-
-    snake->tail->previous_position = snake->tail->current_position;
-
-    snake->tail->next_position = (Vector2){
-        snake->tail->current_position.x + snake->tail->direction.x * TILE_SIZE,
-        snake->tail->current_position.y + snake->tail->direction.y * TILE_SIZE
-    };
-}
-
-void input(Snake *snake,SDL_Event event){
-    Vector2 new_direction = {0.0f};
-
-    if(event.key.keysym.scancode == SDL_SCANCODE_W)      new_direction.y = -1.0f;
-    else if(event.key.keysym.scancode == SDL_SCANCODE_S) new_direction.y = 1.0f;
-    else if(event.key.keysym.scancode == SDL_SCANCODE_A) new_direction.x = -1.0f;
-    else if(event.key.keysym.scancode == SDL_SCANCODE_D) new_direction.x = 1.0f;
-
-    if(!new_direction.x && !new_direction.y) return;
-
-    snake->buffer_direction = new_direction;
-
-    if(!snake->moving){
-        snake->moving = true;
-        SnakeNextMove(snake);
-    }
-}
-
-void PutTailOnHead(Snake *snake){
-    Piece *tail = snake->tail;
-
-    snake->tail = tail->previous;
-    snake->tail->next = NULL;
-
-    snake->head->previous = tail;
-    tail->next = snake->head;
-    tail->previous = NULL;
-    tail->current_position = snake->head->current_position;
-
-    snake->head = tail;
-    snake->body = snake->head;
-}
 
-void PieceMove(Piece *piece,float delta_time){
-    float distanci_x = fabsf(piece->next_position.x - piece->current_position.x);
-    float distanci_y = fabsf(piece->next_position.y - piece->current_position.y);
-
-    if(distanci_x > VELOCITY * delta_time){
-        piece->current_position.x += piece->direction.x * VELOCITY * delta_time;
-    }
-    else if(distanci_y > VELOCITY * delta_time){
-        piece->current_position.y += piece->direction.y * VELOCITY * delta_time;
-    }
-    else{
-        piece->current_position = piece->next_position;
-        piece->direction = (Vector2){0.0f};
-    }
-
-    if(piece->current_position.x < 0.0f && piece->direction.x < 0.0f){
-        piece->current_position.x += COLUMNS * TILE_SIZE;
-        piece->next_position.x += COLUMNS * TILE_SIZE;
-    }
-    else if(piece->current_position.x+TILE_SIZE > COLUMNS * TILE_SIZE && piece->direction.x > 0.0f){
-        piece->current_position.x -= COLUMNS * TILE_SIZE;
-        piece->next_position.x -= COLUMNS * TILE_SIZE;
-    }
-
-    if(piece->current_position.y < 0.0f && piece->direction.y < 0.0f){
-        piece->current_position.y += ROWS * TILE_SIZE;
-        piece->next_position.y += ROWS * TILE_SIZE;
-    }
-    else if(piece->current_position.y+TILE_SIZE > ROWS * TILE_SIZE && piece->direction.y > 0.0f){
-        piece->current_position.y -= ROWS * TILE_SIZE;
-        piece->next_position.y -= ROWS * TILE_SIZE;
-    }
-}
-
-void SnakeMove(Snake *snake,Vector2 *point,float delta_time){
-    if(!snake->moving) return;
-
-    PieceMove(snake->head,delta_time);
-    PieceMove(snake->tail,delta_time);
-
-    if((!snake->head->direction.x && !snake->head->direction.y) && (!snake->tail->direction.x && !snake->tail->direction.y)){
-        
-        PutTailOnHead(snake);
-
-        if(snake->head->current_position.x == point->x && snake->head->current_position.y == point->y){
-            GetPointPosition(point);
-
-            Piece new_piece = {{0.0f},snake->head->previous_position,snake->head->previous_position,snake->head->previous_position,NULL,NULL};
-
-            snake->tail = AddPiece(&snake->body,new_piece);
-        }
-
-        SnakeNextMove(snake);
-    }
-}
-
-void DrawPoint(Renderer *renderer,Vector2 *point,Vector2 translate,Texture *point_texture){
-    Vector2 position = GetIsometricPosition(point->x,point->y);
-    position.x += translate.x;
-    position.y += translate.y;
-    Blit(renderer,point_texture,NULL,&(Rect){position.x,position.y,BLOCK_SIZE,BLOCK_SIZE});
-}
-
-int main(int n_args,char **args){
-    SDL_Init(SDL_INIT_EVERYTHING);
+    time_scale = fmin(fmax(time_scale,MIN_TIME_SCALE),MAX_TIME_SCALE);
 
     srand(time(0));
 
@@ -301,64 +58,295 @@ int main(int n_args,char **args){
 
     Renderer *renderer = CreateRenderer(window,false);
 
-    Texture *floor_texture = CreateTexture(renderer,BLOCK_SIZE,BLOCK_SIZE,PIXEL_FORMAT_RGBA,false,true);
-    RendererSetTarget(renderer,floor_texture);
-    DrawBlock(renderer,(Vector2){BLOCK_SIZE*0.5f,BLOCK_SIZE*0.5f},(Color){0,128,50,255},(Color){0,153,53,255});
-    
-    Texture *piece_texture = CreateTexture(renderer,BLOCK_SIZE,BLOCK_SIZE,PIXEL_FORMAT_RGBA,false,true);
-    RendererSetTarget(renderer,piece_texture);
-    DrawBlock(renderer,(Vector2){BLOCK_SIZE*0.5f,BLOCK_SIZE*0.5f},(Color){200,0,0,255},(Color){200,0,0,255});
+    RenderState *state = CreateRenderState(renderer);
+    Atlas *atlas = CreateAtlas(state);
 
-    Texture *point_texture = CreateTexture(renderer,BLOCK_SIZE,BLOCK_SIZE,PIXEL_FORMAT_RGBA,false,true);
-    RendererSetTarget(renderer,point_texture);
-    DrawBlock(renderer,(Vector2){BLOCK_SIZE*0.5f,BLOCK_SIZE*0.5f},(Color){200,150,0,255},(Color){200,150,0,255});
+    //boards too large for one texture fall back to drawing every piece
+    SnakeLayer *layer = CreateSnakeLayer(renderer);
+    RenderQueue *queue = CreateRenderQueue();
+    LevelOfDetail *lod = CreateLevelOfDetail();
+    Minimap *minimap = CreateMinimap(renderer);
+    Particles *particles = CreateParticles(PARTICLE_CAPACITY);
 
-    RendererSetTarget(renderer,NULL);
+    //without a font the length and fps stay in the title only
+    Hud *hud = CreateHud(state,font_path,HUD_FONT_HEIGHT);
+    char hud_text[HUD_TEXT];
+    double hud_fps = 0.0;
 
     bool run = true;
     SDL_Event event;
-    Vector2 translate = {width*0.5f - TILE_SIZE * 0.5f,height*0.5f - ROWS * TILE_SIZE * 0.5f};
-    float current_time = SDL_GetTicks();
-    float last_time = current_time;
+    Camera camera = {{0.0f,0.0f},1.0f,width,height};
+    CameraZoom(&camera,zoom);
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+    uint64_t current_time = SDL_GetPerformanceCounter();
+    uint64_t last_time = current_time;
     float delta_time = 0;
 
+    FramePacer pacer;
+    FrameStats stats;
+    char title[1024];
+    PacerInit(&pacer,fps,pacing);
+
+    //an uncapped frame rate still aims at 60 fps before trading resolution
+    ResolutionScaler scaler;
+    ScalerInit(&scaler,(fps > 0.0) ? 1.0 / fps : 1.0 / 60.0,resolution,1.0f);
+
     Snake *snake = CreateSnake();
 
     Vector2 point;
     GetPointPosition(&point);
 
+    if(solver_mode){
+        snake->solver = CreateSolver();
+        snake->moving = true;
+        SolverUpdate(snake->solver,snake,&point);
+        SnakeNextMove(snake);
+    }
+
+    bool minimized = false;
+    bool redraw = true;
+    bool was_idle = false;
+    bool overdraw = false;
+    bool debug = false;
+    uint64_t latched = 0;
+    uint64_t frame_steps = 0;
+    float overdraw_average = 0.0f;
+
+    //the view version changes with anything that moves the board on screen
+    uint64_t view_version = 0;
+    FrameCache cache;
+    FrameCacheInit(&cache);
+
     while(run){
+
+        //nothing can change until an event arrives, so block instead of redrawing the same frame
+        if((minimized || (!snake->moving && particles->count == 0)) && !redraw){
+            PacerIdle(&pacer,IDLE_TIMEOUT);
+        }
         
-        current_time = SDL_GetTicks();
-        delta_time = (current_time - last_time) / 1000.0f;
+        current_time = SDL_GetPerformanceCounter();
+        delta_time = (float)(current_time - last_time) / frequency;
         last_time = current_time;
 
-        SDL_PollEvent(&event);
-
-        if(event.type == SDL_QUIT){
-            run = false;
+        while(SDL_PollEvent(&event)){
+            if(event.type == SDL_QUIT){
+                run = false;
+            }
+            else if(event.type == SDL_WINDOWEVENT){
+                switch(event.window.event){
+                    case SDL_WINDOWEVENT_RESIZED:
+                    case SDL_WINDOWEVENT_SIZE_CHANGED:
+                        SDL_GetWindowSize(window,&width,&height);
+                        CameraCenter(&camera,width,height);
+                        view_version++;
+                        redraw = true;
+                        break;
+                    case SDL_WINDOWEVENT_MINIMIZED:
+                    case SDL_WINDOWEVENT_HIDDEN:
+                        minimized = true;
+                        break;
+                    case SDL_WINDOWEVENT_RESTORED:
+                    case SDL_WINDOWEVENT_MAXIMIZED:
+                    case SDL_WINDOWEVENT_SHOWN:
+                        minimized = false;
+                        redraw = true;
+                        break;
+                    case SDL_WINDOWEVENT_EXPOSED:
+                        redraw = true;
+                        break;
+                }
+            }
+            else if(event.type == SDL_MOUSEWHEEL && event.wheel.y != 0){
+                CameraZoom(&camera,powf(ZOOM_STEP,event.wheel.y));
+                view_version++;
+                redraw = true;
+            }
+            else if(event.type == SDL_KEYDOWN && (event.key.keysym.scancode == SDL_SCANCODE_EQUALS || event.key.keysym.scancode == SDL_SCANCODE_MINUS)){
+                CameraZoom(&camera,event.key.keysym.scancode == SDL_SCANCODE_EQUALS ? ZOOM_STEP : 1.0f / ZOOM_STEP);
+                view_version++;
+                redraw = true;
+            }
+            else if(event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_O && GPUStatsEnabled()){
+                overdraw = !overdraw;
+                view_version++;
+                redraw = true;
+            }
+            else if(event.type == SDL_KEYDOWN && (event.key.keysym.scancode == SDL_SCANCODE_LEFTBRACKET || event.key.keysym.scancode == SDL_SCANCODE_RIGHTBRACKET)){
+                time_scale *= (event.key.keysym.scancode == SDL_SCANCODE_RIGHTBRACKET) ? 2.0 : 0.5;
+                time_scale = fmin(fmax(time_scale,MIN_TIME_SCALE),MAX_TIME_SCALE);
+            }
+            else if(event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F3 && DebugDrawEnabled()){
+                debug = !debug;
+                view_version++;
+                redraw = true;
+            }
+            else if(event.type == SDL_KEYDOWN && snake->solver == NULL){
+                input(snake,event);
+            }
         }
-        else if(event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_RESIZED){
-            SDL_GetWindowSize(window,&width,&height);
-            translate = (Vector2){width*0.5f - TILE_SIZE * 0.5f,height*0.5f - ROWS * TILE_SIZE * 0.5f};
+
+        if(minimized || (!snake->moving && particles->count == 0 && !redraw)){
+            was_idle = true;
         }
-        else if(event.type == SDL_KEYDOWN){
-            input(snake,event);
+        else{
+            //the time spent idle must not be simulated when the game resumes
+            if(was_idle){
+                delta_time = 0.0f;
+                PacerResume(&pacer);
+                was_idle = false;
+            }
+
+            //the simulation runs every step of the scaled time without drawing, the layer and the minimap
+            //catch up once per frame by replaying the cells the steps touched from the snake's log
+            //effects slow down with the game but never speed up past real time
+            Vector2 food;
+            float simulation_time = delta_time * time_scale;
+            float effect_time = delta_time * fmin(time_scale,1.0);
+            uint64_t steps = snake->steps;
+            if(SnakeAdvance(snake,&point,simulation_time,&food) > 0) EmitParticles(particles,food,EAT_PARTICLES,EAT_SPEED,EAT_LIFETIME,atlas->sprites[SPRITE_POINT].fill_color);
+            frame_steps = snake->steps - steps;
+            if(layer != NULL) SnakeLayerUpdate(layer,renderer,snake,atlas);
+            MinimapUpdate(minimap,snake,&point,atlas);
+
+            EmitTrail(particles,snake,effect_time,atlas->sprites[SPRITE_PIECE].fill_color);
+            ParticlesUpdate(particles,effect_time);
+
+            //live particles change the frame even when the snake stands still
+            uint64_t scene_version = snake->version + particles->version;
+            FrameAction action = FrameCacheCheck(&cache,scene_version,view_version,redraw);
+
+            //the text is laid out again only when the length or the measured fps change
+            if(hud != NULL){
+                snprintf(hud_text,sizeof(hud_text),"length %d\nfps %.0f",snake->length,hud_fps);
+                HudSetText(hud,hud_text,(Vector2){HUD_MARGIN,HUD_MARGIN},(Color){255,255,255,255});
+            }
+
+            if(action == FRAME_PRESENT){
+                FrameCachePresent(&cache,renderer);
+                DrawMinimap(renderer,minimap,&camera);
+                if(hud != NULL) DrawHud(renderer,hud);
+                if(debug && GPUStatsEnabled()){
+                    DebugBegin(&camera);
+                    DebugDrawGPUStats();
+                    DebugEnd(renderer);
+                }
+                Flip(renderer);
+            }
+            else if(action == FRAME_RENDER){
+                ScalerBegin(&scaler);
+
+                //keys pressed since the poll still reach this frame, the head is drawn one frame of movement ahead,
+                //where it will be when the frame is shown, and only for the drawing
+                Vector2 head_position = snake->head->current_position;
+                if(latch && snake->solver == NULL){
+                    latched += LatchInput(snake);
+                    snake->head->current_position = GetLatchedHeadPosition(snake,VELOCITY * simulation_time);
+                }
+
+                //a frame that stays on screen once the snake stops is kept for the redraws that follow
+                //the board is drawn at the scaler's resolution and stretched over the window
+                //except when measuring overdraw, which counts the draws that reach the screen directly
+                float frame_resolution = overdraw ? 1.0f : scaler.scale;
+                Camera view = GetScaledCamera(&camera,frame_resolution);
+                if(overdraw) OverdrawBegin(width,height);
+                FrameCacheBegin(&cache,state,width,height,frame_resolution,!snake->moving && particles->count == 0 && !overdraw);
+
+                ClearRGBA(renderer,0,0,0,255);
+                Detail detail = GetDetail(&view);
+                if(detail == DETAIL_TEXTURE){
+                    DrawBoardQuad(renderer,minimap->texture,&view);
+                }
+                else if(detail == DETAIL_DIAMONDS){
+                    DrawDiamonds(renderer,lod,snake,&point,&view,atlas);
+                }
+                else{
+                    DrawFloor(queue,&view,atlas);
+                    if(layer == NULL) DrawObjects(queue,snake,&point,&view,atlas);
+                    RenderQueueFlush(queue,state);
+                    if(layer != NULL) DrawSnakeLayer(renderer,layer,snake,&point,&view,atlas);
+                }
+                DrawParticles(renderer,particles,&view);
+
+                if(debug){
+                    DebugBegin(&view);
+                    DebugDrawBoard(snake,&point);
+                    DebugEnd(renderer);
+                }
+
+                FrameCacheEnd(&cache,state,scene_version,view_version);
+                snake->head->current_position = head_position;
+
+                //the minimap, the hud and the gpu counters stay sharp at the window resolution
+                DrawMinimap(renderer,minimap,&camera);
+                if(hud != NULL) DrawHud(renderer,hud);
+                if(debug && GPUStatsEnabled()){
+                    DebugBegin(&camera);
+                    DebugDrawGPUStats();
+                    DebugEnd(renderer);
+                }
+                if(overdraw) overdraw_average = OverdrawEnd(renderer);
+                Flip(renderer);
+
+                RenderQueueEndFrame(queue);
+                StateEndFrame(state);
+                if(!overdraw) ScalerEnd(&scaler);
+            }
+            redraw = false;
+
+            PacerWait(&pacer);
         }
 
-        ClearRGBA(renderer,0,0,0,255);
-        SnakeMove(snake,&point,delta_time);
-        DrawFloor(renderer,translate,floor_texture);
-        DrawPoint(renderer,&point,translate,point_texture);
-        DrawSnake(renderer,snake,translate,piece_texture);
-        Flip(renderer);
+        if(PacerStats(&pacer,&stats)){
+            hud_fps = stats.fps;
+            snprintf(title,sizeof(title),"Snake | %.1f fps | frame %.2f ms | jitter %.3f ms | max error %.3f ms | cpu %.1f%% | sprites %llu hit %llu miss | frames %llu drawn %llu cached %llu skipped | resolution %d%% | queue %llu draws %llu textures %llu blends | state %llu set %llu elided",
+                stats.fps,stats.average * 1000.0,stats.jitter * 1000.0,stats.max_error * 1000.0,stats.cpu * 100.0,
+                (unsigned long long)atlas->hits,(unsigned long long)atlas->misses,
+                (unsigned long long)cache.rendered,(unsigned long long)cache.presented,(unsigned long long)cache.skipped,
+                (int)(scaler.scale * 100.0f + 0.5f),
+                (unsigned long long)queue->last.commands,(unsigned long long)queue->last.textures,(unsigned long long)queue->last.blends,
+                (unsigned long long)state->last.calls,(unsigned long long)state->last.elided);
+            if(time_scale != 1.0){
+                int length = strlen(title);
+                snprintf(title + length,sizeof(title) - length," | speed x%g %llu steps per frame",time_scale,(unsigned long long)frame_steps);
+            }
+            if(snake->solver == NULL){
+                int length = strlen(title);
+                snprintf(title + length,sizeof(title) - length," | turns %llu queued %llu coalesced %llu reversed %llu dropped",
+                    (unsigned long long)snake->turns.queued,(unsigned long long)snake->turns.coalesced,(unsigned long long)snake->turns.reversed,(unsigned long long)snake->turns.dropped);
+            }
+            if(latch){
+                int length = strlen(title);
+                snprintf(title + length,sizeof(title) - length," | latched %llu keys",(unsigned long long)latched);
+            }
+            if(hud != NULL){
+                int length = strlen(title);
+                snprintf(title + length,sizeof(title) - length," | hud %llu layouts %llu unchanged",(unsigned long long)hud->layouts,(unsigned long long)hud->unchanged);
+            }
+            if(GPUStatsEnabled()){
+                GPUStats gpu = GetGPUStats();
+                int length = strlen(title);
+                snprintf(title + length,sizeof(title) - length," | gpu %llu blits %llu geometry %llu polygons %llu flushes %llu vertices %llu indices %llu binds %llu targets",
+                    (unsigned long long)gpu.blits,(unsigned long long)gpu.geometries,(unsigned long long)gpu.polygons,(unsigned long long)gpu.flushes,
+                    (unsigned long long)gpu.vertices,(unsigned long long)gpu.indices,(unsigned long long)gpu.binds,(unsigned long long)gpu.targets);
+                length = strlen(title);
+                if(overdraw) snprintf(title + length,sizeof(title) - length," | overdraw %.2fx",overdraw_average);
+            }
+            SDL_SetWindowTitle(window,title);
+        }
     }
 
+    if(snake->solver != NULL) SolverFree(snake->solver);
     SnakeFree(snake);
 
-    TextureFree(floor_texture);
-    TextureFree(piece_texture);
-    TextureFree(point_texture);
+    FrameCacheFree(&cache);
+    if(layer != NULL) SnakeLayerFree(layer);
+    LevelOfDetailFree(lod);
+    MinimapFree(minimap);
+    ParticlesFree(particles);
+    if(hud != NULL) HudFree(hud);
+    RenderQueueFree(queue);
+    AtlasFree(atlas);
+    RenderStateFree(state);
 
     RendererFree(renderer);
     SDL_DestroyWindow(window);
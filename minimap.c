@@ -0,0 +1,157 @@
+#include "minimap.h"
+
+//one texel per cell, kept in step with the board by rewriting only the cells the steps since the last update touched:
+//the cells the tail left, the cells the head entered and the old and new cells of the food
+
+Minimap* CreateMinimap(Renderer *renderer){
+    Minimap *minimap = malloc(sizeof(Minimap));
+    minimap->texture = CreateTexture(renderer,columns,rows,PIXEL_FORMAT_RGBA,false,false);
+    SetTextureFilter(minimap->texture,FILTER_LINEAR,FILTER_NEAREST);
+    minimap->counts = calloc(columns * rows,sizeof(uint16_t));
+    minimap->touched = calloc(columns * rows,sizeof(uint8_t));
+    minimap->cells = malloc(sizeof(int) * (STEP_LOG * 2 + 2));
+
+    minimap->point_cell = 0;
+    minimap->steps = 0;
+    minimap->valid = false;
+
+    minimap->texels = 0;
+    minimap->rebuilds = 0;
+
+    return minimap;
+}
+
+void MinimapFree(Minimap *minimap){
+    TextureFree(minimap->texture);
+    free(minimap->counts);
+    free(minimap->touched);
+    free(minimap->cells);
+    free(minimap);
+}
+
+//the cell a piece rests on, the head and the tail leave theirs only when the next step completes
+static int GetRestCell(Snake *snake,Piece *piece){
+    if(snake->moving && (piece == snake->head || piece == snake->tail)) return GetCell(piece->previous_position);
+    return GetCell(piece->current_position);
+}
+
+static Color GetCellColor(Minimap *minimap,int cell,Atlas *atlas){
+    if(cell == minimap->point_cell) return atlas->sprites[SPRITE_POINT].fill_color;
+    if(minimap->counts[cell] > 0) return atlas->sprites[SPRITE_PIECE].fill_color;
+    return atlas->sprites[SPRITE_FLOOR].fill_color;
+}
+
+static void WriteCell(Minimap *minimap,int cell,Atlas *atlas){
+    void *pixels;
+    int pitch;
+    LockTexture(minimap->texture,&(Rect){cell % columns,cell / columns,1,1},&pixels,&pitch);
+    *(Color*)pixels = GetCellColor(minimap,cell,atlas);
+    UnlockTexture(minimap->texture);
+    minimap->texels++;
+}
+
+void MinimapRebuild(Minimap *minimap,Snake *snake,Vector2 *point,Atlas *atlas){
+    //the head leaves from the cell of the piece behind it, that one already covers it
+    memset(minimap->counts,0,sizeof(uint16_t) * columns * rows);
+    for(Piece *piece = snake->head->next; piece != NULL; piece = piece->next){
+        minimap->counts[GetRestCell(snake,piece)]++;
+    }
+    minimap->point_cell = GetCell(*point);
+
+    void *pixels;
+    int pitch;
+    LockTexture(minimap->texture,NULL,&pixels,&pitch);
+    for(int y=0; y<rows; ++y){
+        Color *row = (Color*)((uint8_t*)pixels + y * pitch);
+        for(int x=0; x<columns; ++x){
+            row[x] = GetCellColor(minimap,y * columns + x,atlas);
+        }
+    }
+    UnlockTexture(minimap->texture);
+
+    minimap->steps = snake->steps;
+    minimap->valid = true;
+    minimap->texels += columns * rows;
+    minimap->rebuilds++;
+}
+
+static void TouchCell(Minimap *minimap,int cell,int *count){
+    if(minimap->touched[cell]) return;
+    minimap->touched[cell] = 1;
+    minimap->cells[(*count)++] = cell;
+}
+
+//replays the steps of the snake's log since the last update, each touched cell is written once,
+//only falling further behind than the log holds costs a full rebuild
+void MinimapUpdate(Minimap *minimap,Snake *snake,Vector2 *point,Atlas *atlas){
+    if(minimap->valid && minimap->steps == snake->steps) return;
+
+    if(!minimap->valid || snake->steps - minimap->steps > STEP_LOG){
+        MinimapRebuild(minimap,snake,point,atlas);
+        return;
+    }
+
+    int count = 0;
+
+    //the old head came to rest behind the new one, the old tail left its cell unless a piece grew there
+    for(uint64_t step = minimap->steps + 1; step <= snake->steps; ++step){
+        StepChange *change = &snake->changes[step % STEP_LOG];
+        if(!change->grew){
+            minimap->counts[change->vacated]--;
+            TouchCell(minimap,change->vacated,&count);
+        }
+        minimap->counts[change->entered]++;
+        TouchCell(minimap,change->entered,&count);
+    }
+
+    int point_cell = GetCell(*point);
+    if(point_cell != minimap->point_cell){
+        TouchCell(minimap,minimap->point_cell,&count);
+        TouchCell(minimap,point_cell,&count);
+        minimap->point_cell = point_cell;
+    }
+
+    for(int i=0; i<count; ++i){
+        WriteCell(minimap,minimap->cells[i],atlas);
+        minimap->touched[minimap->cells[i]] = 0;
+    }
+
+    minimap->steps = snake->steps;
+}
+
+//the texture stretched over the board as one quad, its corners are the corners of the top faces of the floor
+void DrawBoardQuad(Renderer *renderer,Texture *texture,Camera *camera){
+    Vector2 corners[4] = {
+        {0.0f,0.0f},
+        {columns * TILE_SIZE,0.0f},
+        {columns * TILE_SIZE,rows * TILE_SIZE},
+        {0.0f,rows * TILE_SIZE}
+    };
+    Vector2 texcoords[4] = {{0.0f,0.0f},{1.0f,0.0f},{1.0f,1.0f},{0.0f,1.0f}};
+
+    Vertex vertices[4];
+    for(int i=0; i<4; ++i){
+        Rect rect = GetScreenRect(camera,corners[i],TILE_SIZE);
+        vertices[i] = (Vertex){{rect.x + rect.w * 0.5f,rect.y},{255,255,255,255},texcoords[i]};
+    }
+    unsigned int indices[6] = {0,1,2,0,2,3};
+
+    Geometry(renderer,texture,vertices,4,indices,6);
+}
+
+//the board in the top right corner, at the scale that fits it in MINIMAP_SIZE pixels
+void DrawMinimap(Renderer *renderer,Minimap *minimap,Camera *camera){
+    float width = (columns + rows) * TILE_SIZE;
+    float height = (columns + rows) * TILE_SIZE * 0.5f;
+    float scale = MINIMAP_SIZE / fmaxf(width,height);
+
+    Vector2 left = GetIsometricPosition(0.0f,rows * TILE_SIZE);
+    Camera corner = {
+        {camera->width - MINIMAP_MARGIN - width * scale - (left.x + TILE_SIZE) * scale,MINIMAP_MARGIN - TILE_SIZE * scale},
+        scale,
+        MINIMAP_SIZE,
+        MINIMAP_SIZE
+    };
+
+    DrawBoardQuad(renderer,minimap->texture,&corner);
+}
@@ -0,0 +1,36 @@
+#ifndef MINIMAP_H_
+#define MINIMAP_H_
+
+#include "snake.h"
+
+#define MINIMAP_SIZE 200
+#define MINIMAP_MARGIN 10
+
+typedef struct _Minimap{
+    Texture *texture;
+    uint16_t *counts;
+    uint8_t *touched;
+    int *cells;
+
+    int point_cell;
+    uint64_t steps;
+    bool valid;
+
+    uint64_t texels;
+    uint64_t rebuilds;
+}Minimap;
+
+
+Minimap* CreateMinimap(Renderer *renderer);
+
+void MinimapFree(Minimap *minimap);
+
+void MinimapRebuild(Minimap *minimap,Snake *snake,Vector2 *point,Atlas *atlas);
+
+void MinimapUpdate(Minimap *minimap,Snake *snake,Vector2 *point,Atlas *atlas);
+
+void DrawBoardQuad(Renderer *renderer,Texture *texture,Camera *camera);
+
+void DrawMinimap(Renderer *renderer,Minimap *minimap,Camera *camera);
+
+#endif
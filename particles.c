@@ -0,0 +1,166 @@
+#include "particles.h"
+
+//every array is sized for the whole pool up front and the quad indices never change,
+//so emitting, updating and drawing never allocate
+
+Particles* CreateParticles(int capacity){
+    Particles *particles = malloc(sizeof(Particles));
+    particles->count = 0;
+    particles->capacity = capacity;
+
+    particles->x = malloc(sizeof(float) * capacity);
+    particles->y = malloc(sizeof(float) * capacity);
+    particles->z = malloc(sizeof(float) * capacity);
+    particles->vx = malloc(sizeof(float) * capacity);
+    particles->vy = malloc(sizeof(float) * capacity);
+    particles->vz = malloc(sizeof(float) * capacity);
+    particles->life = malloc(sizeof(float) * capacity);
+    particles->lifetime = malloc(sizeof(float) * capacity);
+    particles->color = malloc(sizeof(Color) * capacity);
+
+    particles->vertices = malloc(sizeof(Vertex) * capacity * 4);
+    particles->indices = malloc(sizeof(unsigned int) * capacity * 6);
+    for(int i=0; i<capacity; ++i){
+        unsigned int first = i * 4;
+        unsigned int *index = particles->indices + i * 6;
+        index[0] = first;
+        index[1] = first + 1;
+        index[2] = first + 2;
+        index[3] = first;
+        index[4] = first + 2;
+        index[5] = first + 3;
+    }
+
+    particles->trail = 0.0f;
+    particles->version = 0;
+    particles->emitted = 0;
+    particles->dropped = 0;
+
+    return particles;
+}
+
+void ParticlesFree(Particles *particles){
+    free(particles->x);
+    free(particles->y);
+    free(particles->z);
+    free(particles->vx);
+    free(particles->vy);
+    free(particles->vz);
+    free(particles->life);
+    free(particles->lifetime);
+    free(particles->color);
+    free(particles->vertices);
+    free(particles->indices);
+    free(particles);
+}
+
+static float RandomFloat(float min,float max){
+    return min + (max - min) * ((float)rand() / RAND_MAX);
+}
+
+//a burst from the center of the top face of the cell at position, spread over the board and thrown up
+//particles that don't fit in the pool are dropped
+void EmitParticles(Particles *particles,Vector2 position,int count,float speed,float lifetime,Color color){
+    for(int i=0; i<count; ++i){
+        if(particles->count == particles->capacity){
+            particles->emitted += i;
+            particles->dropped += count - i;
+            return;
+        }
+
+        int j = particles->count++;
+        float angle = RandomFloat(0.0f,2.0f * (float)M_PI);
+        float velocity = speed * RandomFloat(0.3f,1.0f);
+
+        particles->x[j] = position.x + TILE_SIZE * 0.5f;
+        particles->y[j] = position.y + TILE_SIZE * 0.5f;
+        particles->z[j] = 0.0f;
+        particles->vx[j] = cosf(angle) * velocity;
+        particles->vy[j] = sinf(angle) * velocity;
+        particles->vz[j] = speed * RandomFloat(0.5f,1.5f);
+        particles->life[j] = lifetime * RandomFloat(0.5f,1.0f);
+        particles->lifetime[j] = particles->life[j];
+        particles->color[j] = color;
+    }
+    particles->emitted += count;
+}
+
+//a steady trickle from where the head is, in time with the frame rate
+void EmitTrail(Particles *particles,Snake *snake,float delta_time,Color color){
+    if(!snake->moving) return;
+
+    particles->trail += TRAIL_RATE * delta_time;
+    int count = (int)particles->trail;
+    particles->trail -= count;
+    if(count > 0) EmitParticles(particles,snake->head->current_position,count,TRAIL_SPEED,TRAIL_LIFETIME,color);
+}
+
+//the integration is one branch free loop per field, then dead particles are replaced by the last live one
+void ParticlesUpdate(Particles *particles,float delta_time){
+    int count = particles->count;
+    if(count == 0 || delta_time <= 0.0f) return;
+
+    float *restrict x = particles->x;
+    float *restrict y = particles->y;
+    float *restrict z = particles->z;
+    float *restrict vx = particles->vx;
+    float *restrict vy = particles->vy;
+    float *restrict vz = particles->vz;
+    float *restrict life = particles->life;
+
+    for(int i=0; i<count; ++i){
+        vz[i] -= PARTICLE_GRAVITY * delta_time;
+        x[i] += vx[i] * delta_time;
+        y[i] += vy[i] * delta_time;
+        z[i] = fmaxf(z[i] + vz[i] * delta_time,0.0f);
+        life[i] -= delta_time;
+    }
+
+    for(int i=0; i<count; ){
+        if(life[i] > 0.0f){
+            ++i;
+            continue;
+        }
+        --count;
+        x[i] = x[count];
+        y[i] = y[count];
+        z[i] = z[count];
+        vx[i] = vx[count];
+        vy[i] = vy[count];
+        vz[i] = vz[count];
+        life[i] = life[count];
+        particles->lifetime[i] = particles->lifetime[count];
+        particles->color[i] = particles->color[count];
+    }
+
+    particles->count = count;
+    particles->version++;
+}
+
+//one untextured quad per particle, fading out with its life, all of them in a single Geometry call
+void DrawParticles(Renderer *renderer,Particles *particles,Camera *camera){
+    if(particles->count == 0) return;
+
+    float size = fmaxf(PARTICLE_SIZE * camera->scale,1.0f);
+    Vertex *vertex = particles->vertices;
+    int count = 0;
+
+    for(int i=0; i<particles->count; ++i){
+        Vector2 iso = GetIsometricPosition(particles->x[i],particles->y[i]);
+        float sx = camera->translate.x + (iso.x + TILE_SIZE) * camera->scale;
+        float sy = camera->translate.y + (iso.y - particles->z[i]) * camera->scale;
+        if(sx + size < 0.0f || sy + size < 0.0f || sx - size > camera->width || sy - size > camera->height) continue;
+
+        Color color = particles->color[i];
+        color.a = (uint8_t)(color.a * fminf(particles->life[i] / particles->lifetime[i],1.0f));
+
+        vertex[0] = (Vertex){{sx - size * 0.5f,sy - size * 0.5f},color,{0.0f,0.0f}};
+        vertex[1] = (Vertex){{sx + size * 0.5f,sy - size * 0.5f},color,{0.0f,0.0f}};
+        vertex[2] = (Vertex){{sx + size * 0.5f,sy + size * 0.5f},color,{0.0f,0.0f}};
+        vertex[3] = (Vertex){{sx - size * 0.5f,sy + size * 0.5f},color,{0.0f,0.0f}};
+        vertex += 4;
+        count++;
+    }
+
+    if(count > 0) Geometry(renderer,NULL,particles->vertices,count * 4,particles->indices,count * 6);
+}
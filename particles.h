@@ -0,0 +1,56 @@
+#ifndef PARTICLES_H_
+#define PARTICLES_H_
+
+#include "snake.h"
+
+#define PARTICLE_CAPACITY 131072
+#define PARTICLE_SIZE 3.0f
+#define PARTICLE_GRAVITY 240.0f
+
+#define EAT_PARTICLES 96
+#define EAT_SPEED 90.0f
+#define EAT_LIFETIME 0.8f
+
+#define TRAIL_RATE 60.0f
+#define TRAIL_SPEED 12.0f
+#define TRAIL_LIFETIME 0.5f
+
+//structure of arrays, each loop over the pool touches only the fields it needs
+//positions are board pixels with z as the height above the top of the blocks
+typedef struct _Particles{
+    int count;
+    int capacity;
+
+    float *x;
+    float *y;
+    float *z;
+    float *vx;
+    float *vy;
+    float *vz;
+    float *life;
+    float *lifetime;
+    Color *color;
+
+    Vertex *vertices;
+    unsigned int *indices;
+
+    float trail;
+    uint64_t version;
+    uint64_t emitted;
+    uint64_t dropped;
+}Particles;
+
+
+Particles* CreateParticles(int capacity);
+
+void ParticlesFree(Particles *particles);
+
+void EmitParticles(Particles *particles,Vector2 position,int count,float speed,float lifetime,Color color);
+
+void EmitTrail(Particles *particles,Snake *snake,float delta_time,Color color);
+
+void ParticlesUpdate(Particles *particles,float delta_time);
+
+void DrawParticles(Renderer *renderer,Particles *particles,Camera *camera);
+
+#endif
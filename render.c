@@ -0,0 +1,130 @@
+#include "render.h"
+
+//draws are queued with a 64 bit key and submitted in key order, the key from the top bits down is
+//the layer, the depth, the texture and the blend mode, so inside a depth the draws sharing a texture
+//and a blend mode end up next to each other and equal keys keep the order they were pushed in
+
+RenderQueue* CreateRenderQueue(){
+    RenderQueue *queue = malloc(sizeof(RenderQueue));
+    queue->count = 0;
+    queue->capacity = 0;
+    queue->commands = NULL;
+    queue->keys = NULL;
+    queue->sorted_keys = NULL;
+    queue->order = NULL;
+    queue->sorted_order = NULL;
+
+    queue->texture_count = 0;
+
+    queue->frame = (RenderStats){0,0,0};
+    queue->last = (RenderStats){0,0,0};
+    return queue;
+}
+
+void RenderQueueFree(RenderQueue *queue){
+    free(queue->commands);
+    free(queue->keys);
+    free(queue->sorted_keys);
+    free(queue->order);
+    free(queue->sorted_order);
+    free(queue);
+}
+
+//depths are biased so the few negative ones of pieces sliding across the wrap sort first
+uint64_t GetRenderKey(RenderLayer layer,int depth,int texture,BlendModePreset blend){
+    return ((uint64_t)layer << RENDER_LAYER_SHIFT) |
+           ((uint64_t)((uint32_t)depth ^ 0x80000000u) << RENDER_DEPTH_SHIFT) |
+           ((uint64_t)(texture & 0xFF) << RENDER_TEXTURE_SHIFT) |
+           ((uint64_t)(blend & 0xFF) << RENDER_BLEND_SHIFT);
+}
+
+//small index of a texture for the key, the few textures of the game are looked up linearly
+static int GetTextureIndex(RenderQueue *queue,Texture *texture){
+    for(int i=0; i<queue->texture_count; ++i){
+        if(queue->textures[i] == texture) return i;
+    }
+    if(queue->texture_count == RENDER_TEXTURES) return RENDER_TEXTURES - 1;
+    queue->textures[queue->texture_count] = texture;
+    return queue->texture_count++;
+}
+
+void RenderQueuePush(RenderQueue *queue,RenderLayer layer,int depth,Texture *texture,BlendModePreset blend,Rect *src,Rect *dst){
+    if(queue->count == queue->capacity){
+        queue->capacity = queue->capacity ? queue->capacity * 2 : 256;
+        queue->commands = realloc(queue->commands,sizeof(RenderCommand) * queue->capacity);
+        queue->keys = realloc(queue->keys,sizeof(uint64_t) * queue->capacity);
+        queue->sorted_keys = realloc(queue->sorted_keys,sizeof(uint64_t) * queue->capacity);
+        queue->order = realloc(queue->order,sizeof(int) * queue->capacity);
+        queue->sorted_order = realloc(queue->sorted_order,sizeof(int) * queue->capacity);
+    }
+    queue->keys[queue->count] = GetRenderKey(layer,depth,GetTextureIndex(queue,texture),blend);
+    queue->order[queue->count] = queue->count;
+    queue->commands[queue->count++] = (RenderCommand){texture,blend,*src,*dst};
+}
+
+//least significant digit radix sort over the bytes of the keys, stable and linear in the number of draws
+//only keys and indices are moved, and a byte every key shares is skipped without a pass
+void RenderQueueSort(RenderQueue *queue){
+    int offsets[256];
+
+    for(int shift=0; shift<64; shift+=8){
+        memset(offsets,0,sizeof(offsets));
+        for(int i=0; i<queue->count; ++i){
+            offsets[(queue->keys[i] >> shift) & 0xFF]++;
+        }
+        if(offsets[(queue->keys[0] >> shift) & 0xFF] == queue->count) continue;
+
+        int sum = 0;
+        for(int i=0; i<256; ++i){
+            int count = offsets[i];
+            offsets[i] = sum;
+            sum += count;
+        }
+
+        for(int i=0; i<queue->count; ++i){
+            int j = offsets[(queue->keys[i] >> shift) & 0xFF]++;
+            queue->sorted_keys[j] = queue->keys[i];
+            queue->sorted_order[j] = queue->order[i];
+        }
+
+        uint64_t *keys = queue->keys;
+        queue->keys = queue->sorted_keys;
+        queue->sorted_keys = keys;
+        int *order = queue->order;
+        queue->order = queue->sorted_order;
+        queue->sorted_order = order;
+    }
+}
+
+//one pass over the sorted draws into the current target, the blend mode is set where it changes
+//and put back to normal at the end, the shadow state drops the calls for a mode already set
+void RenderQueueFlush(RenderQueue *queue,RenderState *state){
+    if(queue->count == 0) return;
+    RenderQueueSort(queue);
+
+    Texture *texture = NULL;
+    BlendModePreset blend = queue->commands[queue->order[0]].blend;
+    StateSetBlendMode(state,state->target,blend);
+    for(int i=0; i<queue->count; ++i){
+        RenderCommand *command = &queue->commands[queue->order[i]];
+        if(command->texture != texture){
+            texture = command->texture;
+            queue->frame.textures++;
+        }
+        if(command->blend != blend){
+            blend = command->blend;
+            StateSetBlendMode(state,state->target,blend);
+            queue->frame.blends++;
+        }
+        Blit(state->renderer,command->texture,&command->src,&command->dst);
+    }
+    StateSetBlendMode(state,state->target,BLEND_NORMAL);
+
+    queue->frame.commands += queue->count;
+    queue->count = 0;
+}
+
+void RenderQueueEndFrame(RenderQueue *queue){
+    queue->last = queue->frame;
+    queue->frame = (RenderStats){0,0,0};
+}
@@ -0,0 +1,65 @@
+#ifndef RENDER_H_
+#define RENDER_H_
+
+#include "gpu_stats.h"
+
+#include "state.h"
+
+#define RENDER_TEXTURES 256
+
+#define RENDER_LAYER_SHIFT 56
+#define RENDER_DEPTH_SHIFT 24
+#define RENDER_TEXTURE_SHIFT 16
+#define RENDER_BLEND_SHIFT 8
+
+typedef enum _RenderLayer{
+    RENDER_LAYER_FLOOR,
+    RENDER_LAYER_OBJECTS,
+    RENDER_LAYER_OVERLAY,
+}RenderLayer;
+
+typedef struct _RenderCommand{
+    Texture *texture;
+    BlendModePreset blend;
+    Rect src;
+    Rect dst;
+}RenderCommand;
+
+typedef struct _RenderStats{
+    uint64_t commands;
+    uint64_t textures;
+    uint64_t blends;
+}RenderStats;
+
+typedef struct _RenderQueue{
+    int count;
+    int capacity;
+    RenderCommand *commands;
+    uint64_t *keys;
+    uint64_t *sorted_keys;
+    int *order;
+    int *sorted_order;
+
+    Texture *textures[RENDER_TEXTURES];
+    int texture_count;
+
+    RenderStats frame;
+    RenderStats last;
+}RenderQueue;
+
+
+RenderQueue* CreateRenderQueue();
+
+void RenderQueueFree(RenderQueue *queue);
+
+uint64_t GetRenderKey(RenderLayer layer,int depth,int texture,BlendModePreset blend);
+
+void RenderQueuePush(RenderQueue *queue,RenderLayer layer,int depth,Texture *texture,BlendModePreset blend,Rect *src,Rect *dst);
+
+void RenderQueueSort(RenderQueue *queue);
+
+void RenderQueueFlush(RenderQueue *queue,RenderState *state);
+
+void RenderQueueEndFrame(RenderQueue *queue);
+
+#endif
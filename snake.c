@@ -0,0 +1,710 @@
+#include "snake.h"
+
+int columns = COLUMNS;
+int rows = ROWS;
+
+void GetPointPosition(Vector2 *point){
+    point->x = (rand() % columns) * TILE_SIZE;
+    point->y = (rand() % rows) * TILE_SIZE;
+}
+
+Vector2 GetIsometricPosition(float x,float y){
+    return (Vector2){x - y,(y + x) * 0.5f};
+}
+
+//keeps the middle of the board in the middle of the screen at the current scale
+void CameraCenter(Camera *camera,int width,int height){
+    Vector2 center = GetIsometricPosition(columns * TILE_SIZE * 0.5f,rows * TILE_SIZE * 0.5f);
+    camera->width = width;
+    camera->height = height;
+    camera->translate = (Vector2){
+        width * 0.5f - (center.x + TILE_SIZE * 0.5f) * camera->scale,
+        height * 0.5f - center.y * camera->scale
+    };
+}
+
+void CameraZoom(Camera *camera,float factor){
+    camera->scale *= factor;
+    if(camera->scale < MIN_ZOOM) camera->scale = MIN_ZOOM;
+    else if(camera->scale > MAX_ZOOM) camera->scale = MAX_ZOOM;
+    CameraCenter(camera,camera->width,camera->height);
+}
+
+//the same view drawn to a target scaled by resolution
+Camera GetScaledCamera(Camera *camera,float resolution){
+    return (Camera){
+        {camera->translate.x * resolution,camera->translate.y * resolution},
+        camera->scale * resolution,
+        (int)ceilf(camera->width * resolution),
+        (int)ceilf(camera->height * resolution)
+    };
+}
+
+//screen rect of the block sprite at a board position, lift moves it down like the floor that sits one tile lower
+Rect GetScreenRect(Camera *camera,Vector2 position,float lift){
+    Vector2 iso = GetIsometricPosition(position.x,position.y);
+    return (Rect){
+        camera->translate.x + iso.x * camera->scale,
+        camera->translate.y + (iso.y + lift) * camera->scale,
+        BLOCK_SIZE * camera->scale,
+        BLOCK_SIZE * camera->scale
+    };
+}
+
+bool RectVisible(Camera *camera,Rect *rect){
+    return rect->x + rect->w > 0.0f && rect->y + rect->h > 0.0f && rect->x < camera->width && rect->y < camera->height;
+}
+
+//the cells whose sprites can reach the screen, as ranges of the diagonals u = x - y and v = x + y
+CellRange GetVisibleCells(Camera *camera,float lift){
+    float cell = TILE_SIZE * camera->scale;
+    CellRange range = {
+        (int)floorf(-camera->translate.x / cell) - 2,
+        (int)ceilf((camera->width - camera->translate.x) / cell),
+        (int)floorf((-camera->translate.y / camera->scale - BLOCK_SIZE - lift) * 2.0f / TILE_SIZE),
+        (int)ceilf(((camera->height - camera->translate.y) / camera->scale - lift) * 2.0f / TILE_SIZE)
+    };
+
+    if(range.u0 < 1 - rows) range.u0 = 1 - rows;
+    if(range.u1 > columns - 1) range.u1 = columns - 1;
+    if(range.v0 < 0) range.v0 = 0;
+    if(range.v1 > columns + rows - 2) range.v1 = columns + rows - 2;
+
+    return range;
+}
+
+//the first and last x of diagonal v that fall inside the range and on the board
+void GetDiagonalCells(CellRange *range,int v,int *x0,int *x1){
+    *x0 = (int)ceilf((v + range->u0) * 0.5f);
+    *x1 = (int)floorf((v + range->u1) * 0.5f);
+    if(*x0 < v - rows + 1) *x0 = v - rows + 1;
+    if(*x0 < 0) *x0 = 0;
+    if(*x1 > v) *x1 = v;
+    if(*x1 > columns - 1) *x1 = columns - 1;
+}
+
+Piece* AddPiece(Piece **body,Piece source){
+    Piece *piece = malloc(sizeof(Piece));
+    *piece = source;
+
+    if(*body == NULL){
+        *body = piece;
+        piece->next = NULL;
+        piece->previous = NULL;
+    }
+    else{
+        Piece *buffer = *body;
+        while(buffer->next != NULL){buffer = buffer->next;}
+        buffer->next = piece;
+        piece->previous = buffer;
+        piece->next = NULL;
+    }
+
+    return piece;
+}
+
+static Vector2 GetZigzagPosition(int index){
+    int y = index / columns;
+    int x = (y % 2 == 0) ? index % columns : columns - 1 - index % columns;
+    return (Vector2){x * TILE_SIZE,y * TILE_SIZE};
+}
+
+//lays the body out row by row in a zigzag from the first cell, the tail there and the head on the cell of the neck
+Snake* CreateSnakeOfLength(int length){
+    
+    Snake *snake = malloc(sizeof(Snake));
+    snake->moving = false;
+    snake->length = length;
+    snake->steps = 0;
+    snake->version = 0;
+    snake->buffer_direction = (Vector2){0.0f,0.0f};
+    snake->turns = (TurnQueue){0};
+    snake->solver = NULL;
+    snake->body = NULL;
+    snake->head = NULL;
+    snake->tail = NULL;
+
+    for(int i=0; i<length; ++i){
+        Vector2 position = GetZigzagPosition((i < length - 1) ? i : length - 2);
+        Piece *piece = malloc(sizeof(Piece));
+        *piece = (Piece){{0.0f,0.0f},position,position,position,snake->body,NULL};
+        if(snake->body != NULL) snake->body->previous = piece;
+        else snake->tail = piece;
+        snake->body = piece;
+    }
+    snake->head = snake->body;
+
+    return snake;
+}
+
+Snake* CreateSnake(){
+    return CreateSnakeOfLength(4);
+}
+
+void SnakeFree(Snake *snake){
+    Piece *piece = snake->body;
+    Piece *buffer;
+    while(piece != NULL){
+        buffer = piece->next;
+        free(piece);
+        piece = buffer;
+    }
+    free(snake);
+}
+
+void DrawBlock(Renderer *renderer,Vector2 position,float size,Color border_color,Color fill_color){
+
+    float half = size * 0.5f;
+    float quarter = size * 0.25f;
+
+    Vector2 top_face[4] = {
+        {position.x,position.y},
+        {position.x+half,position.y-quarter},
+        {position.x,position.y-half},
+        {position.x-half,position.y-quarter}
+    };
+
+    Vector2 left_face[4] = {
+        {position.x,position.y},
+        {position.x,position.y+half},
+        {position.x-half,position.y+quarter},
+        {position.x-half,position.y-quarter}
+    };
+
+    Vector2 right_face[4] = {
+        {position.x,position.y},
+        {position.x+half,position.y-quarter},
+        {position.x+half,position.y+quarter},
+        {position.x,position.y+half}
+    };
+
+    DrawFilledPolygon(renderer,top_face,4,fill_color);
+    DrawFilledPolygon(renderer,left_face,4,fill_color);
+    DrawFilledPolygon(renderer,right_face,4,fill_color);
+
+    DrawPolygon(renderer,top_face,4,border_color);
+    DrawPolygon(renderer,left_face,4,border_color);
+    DrawPolygon(renderer,right_face,4,border_color);
+}
+
+Atlas* CreateAtlas(RenderState *state){
+    Atlas *atlas = malloc(sizeof(Atlas));
+    atlas->renderer = state->renderer;
+    atlas->state = state;
+    atlas->texture = CreateTexture(atlas->renderer,ATLAS_COLUMNS * ATLAS_SLOT,ATLAS_ROWS * ATLAS_SLOT,PIXEL_FORMAT_RGBA,false,true);
+
+    atlas->count = 0;
+    atlas->clock = 0;
+    atlas->hits = 0;
+    atlas->misses = 0;
+    atlas->evictions = 0;
+    for(int i=0; i<ATLAS_BUCKETS; ++i) atlas->buckets[i] = -1;
+
+    atlas->sprites[SPRITE_FLOOR] = (SpriteKey){{0,128,50,255},{0,153,53,255},BLOCK_SIZE};
+    atlas->sprites[SPRITE_PIECE] = (SpriteKey){{200,0,0,255},{200,0,0,255},BLOCK_SIZE};
+    atlas->sprites[SPRITE_POINT] = (SpriteKey){{200,150,0,255},{200,150,0,255},BLOCK_SIZE};
+
+    return atlas;
+}
+
+void AtlasFree(Atlas *atlas){
+    TextureFree(atlas->texture);
+    free(atlas);
+}
+
+//slots keep a transparent border so filtered blits never sample the neighbouring sprite
+Rect GetAtlasSlot(int slot){
+    return (Rect){
+        (slot % ATLAS_COLUMNS) * ATLAS_SLOT + ATLAS_PADDING,
+        (slot / ATLAS_COLUMNS) * ATLAS_SLOT + ATLAS_PADDING,
+        BLOCK_SIZE,
+        BLOCK_SIZE
+    };
+}
+
+static bool SpriteKeyEqual(SpriteKey a,SpriteKey b){
+    return a.size == b.size &&
+        a.border_color.r == b.border_color.r && a.border_color.g == b.border_color.g &&
+        a.border_color.b == b.border_color.b && a.border_color.a == b.border_color.a &&
+        a.fill_color.r == b.fill_color.r && a.fill_color.g == b.fill_color.g &&
+        a.fill_color.b == b.fill_color.b && a.fill_color.a == b.fill_color.a;
+}
+
+static int SpriteKeyBucket(SpriteKey key){
+    uint32_t hash = 2166136261u;
+    uint8_t bytes[8] = {
+        key.border_color.r,key.border_color.g,key.border_color.b,key.border_color.a,
+        key.fill_color.r,key.fill_color.g,key.fill_color.b,key.fill_color.a
+    };
+    for(int i=0; i<8; ++i) hash = (hash ^ bytes[i]) * 16777619u;
+    hash = (hash ^ (uint32_t)key.size) * 16777619u;
+    return hash % ATLAS_BUCKETS;
+}
+
+static void AtlasUnlink(Atlas *atlas,int slot){
+    int *link = &atlas->buckets[SpriteKeyBucket(atlas->keys[slot])];
+    while(*link != slot) link = &atlas->next[*link];
+    *link = atlas->next[slot];
+}
+
+//returns the atlas rect of the block sprite for key, drawing it on first use
+//when every slot is taken the least recently used sprite is replaced
+Rect AtlasGetBlock(Atlas *atlas,SpriteKey key){
+    if(key.size > BLOCK_SIZE) key.size = BLOCK_SIZE;
+
+    Rect rect;
+    int bucket = SpriteKeyBucket(key);
+    atlas->clock++;
+
+    for(int slot = atlas->buckets[bucket]; slot != -1; slot = atlas->next[slot]){
+        if(SpriteKeyEqual(atlas->keys[slot],key)){
+            atlas->last_used[slot] = atlas->clock;
+            atlas->hits++;
+            rect = GetAtlasSlot(slot);
+            rect.w = rect.h = key.size;
+            return rect;
+        }
+    }
+
+    atlas->misses++;
+
+    int slot;
+    if(atlas->count < ATLAS_SLOTS){
+        slot = atlas->count++;
+    }
+    else{
+        slot = 0;
+        for(int i=1; i<ATLAS_SLOTS; ++i){
+            if(atlas->last_used[i] < atlas->last_used[slot]) slot = i;
+        }
+        AtlasUnlink(atlas,slot);
+        atlas->evictions++;
+    }
+
+    atlas->keys[slot] = key;
+    atlas->last_used[slot] = atlas->clock;
+    atlas->next[slot] = atlas->buckets[bucket];
+    atlas->buckets[bucket] = slot;
+
+    rect = GetAtlasSlot(slot);
+
+    //blits queued with the old sprite must reach the target before the slot is redrawn
+    Texture *target = atlas->state->target;
+    FlushBlitBuffer(atlas->renderer);
+    StateSetTarget(atlas->state,atlas->texture);
+    StateSetClip(atlas->state,atlas->texture,&(Rect){rect.x - ATLAS_PADDING,rect.y - ATLAS_PADDING,ATLAS_SLOT,ATLAS_SLOT});
+    ClearRGBA(atlas->renderer,0,0,0,0);
+    StateUnSetClip(atlas->state,atlas->texture);
+    DrawBlock(atlas->renderer,(Vector2){rect.x + key.size*0.5f,rect.y + key.size*0.5f},key.size,key.border_color,key.fill_color);
+    StateSetTarget(atlas->state,target);
+
+    rect.w = rect.h = key.size;
+    return rect;
+}
+
+//the floor blocks overlap along the diagonals, each diagonal is its own depth
+void DrawFloor(RenderQueue *queue,Camera *camera,Atlas *atlas){
+    Rect sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_FLOOR]);
+    CellRange range = GetVisibleCells(camera,TILE_SIZE);
+    int x0,x1;
+    for(int v=range.v0; v<=range.v1; ++v){
+        GetDiagonalCells(&range,v,&x0,&x1);
+        for(int x=x0; x<=x1; ++x){
+            Rect dst = GetScreenRect(camera,(Vector2){x * TILE_SIZE,(v - x) * TILE_SIZE},TILE_SIZE);
+            RenderQueuePush(queue,RENDER_LAYER_FLOOR,v,atlas->texture,BLEND_NORMAL,&sprite,&dst);
+        }
+    }
+}
+
+Vector2 GetTailDirection(Piece *tail){
+    Vector2 direction = {0.0f};
+    if(tail->previous != NULL){
+        direction.x = (tail->previous->current_position.x - tail->current_position.x) / TILE_SIZE;
+        direction.y = (tail->previous->current_position.y - tail->current_position.y) / TILE_SIZE;
+
+        if(direction.x >= (columns-1)){
+            direction.x = -1.0f;
+        }
+        else if(direction.x <= -(columns-1)){
+            direction.x = 1.0f;
+        }
+
+        if(direction.y >= (rows-1)){
+            direction.y = -1.0f;
+        }
+        else if(direction.y <= -(rows-1)){
+            direction.y = 1.0f;
+        }
+    }
+    return direction;
+}
+
+int GetCell(Vector2 position){
+    int x = ((int)roundf(position.x / TILE_SIZE) % columns + columns) % columns;
+    int y = ((int)roundf(position.y / TILE_SIZE) % rows + rows) % rows;
+    return y * columns + x;
+}
+
+Solver* CreateSolver(){
+    Solver *solver = malloc(sizeof(Solver));
+    solver->count = columns * rows;
+    solver->cycle = malloc(sizeof(int) * solver->count);
+    solver->cells = malloc(sizeof(int) * solver->count);
+
+    //starts at the initial tail (0,0), walks the remaining columns row by row in a zigzag and returns up column 0
+    int index = 0;
+    solver->cells[index++] = 0;
+    for(int y=0; y<rows; ++y){
+        for(int i=1; i<columns; ++i){
+            int x = (y % 2 == 0) ? i : columns - i;
+            solver->cells[index++] = y * columns + x;
+        }
+    }
+    for(int y=rows-1; y>0; --y){
+        solver->cells[index++] = y * columns;
+    }
+
+    for(int i=0; i<solver->count; ++i){
+        solver->cycle[solver->cells[i]] = i;
+    }
+
+    return solver;
+}
+
+void SolverFree(Solver *solver){
+    free(solver->cycle);
+    free(solver->cells);
+    free(solver);
+}
+
+int CycleDistance(Solver *solver,int from,int to){
+    return (solver->cycle[to] - solver->cycle[from] + solver->count) % solver->count;
+}
+
+Vector2 GetCellDirection(int from,int to){
+    Vector2 direction = {(to % columns) - (from % columns),(to / columns) - (from / columns)};
+
+    if(direction.x > 1.0f) direction.x = -1.0f;
+    else if(direction.x < -1.0f) direction.x = 1.0f;
+
+    if(direction.y > 1.0f) direction.y = -1.0f;
+    else if(direction.y < -1.0f) direction.y = 1.0f;
+
+    return direction;
+}
+
+void SolverUpdate(Solver *solver,Snake *snake,Vector2 *point){
+    
+    if(snake->length >= solver->count){
+        snake->buffer_direction = (Vector2){0.0f,0.0f};
+        return;
+    }
+
+    int head = GetCell(snake->head->current_position);
+    int next = solver->cells[(solver->cycle[head] + 1) % solver->count];
+
+    //shortcuts are only safe while the body cannot wrap around the cycle back onto the head
+    if(snake->length * 2 < solver->count){
+        int tail_distance = CycleDistance(solver,head,GetCell(snake->tail->current_position));
+        int point_distance = CycleDistance(solver,head,GetCell(*point));
+        int best = 1;
+
+        int x = head % columns;
+        int y = head / columns;
+        int neighbors[4] = {
+            y * columns + (x + 1) % columns,
+            y * columns + (x + columns - 1) % columns,
+            ((y + 1) % rows) * columns + x,
+            ((y + rows - 1) % rows) * columns + x
+        };
+
+        for(int i=0; i<4; ++i){
+            int distance = CycleDistance(solver,head,neighbors[i]);
+            //keep room for the growth of the next point and never jump past it
+            if(distance > best && distance < tail_distance - 3 && distance <= point_distance){
+                best = distance;
+                next = neighbors[i];
+            }
+        }
+    }
+
+    snake->buffer_direction = GetCellDirection(head,next);
+}
+
+void SnakeNextMove(Snake *snake){
+
+    if(snake->turns.count > 0){
+        snake->buffer_direction = snake->turns.turns[snake->turns.first];
+        snake->turns.first = (snake->turns.first + 1) % TURN_QUEUE;
+        snake->turns.count--;
+    }
+
+    if(!snake->buffer_direction.x && !snake->buffer_direction.y){
+        snake->moving = false;
+        return;
+    }
+
+    snake->head->direction = snake->buffer_direction;
+    
+    snake->head->previous_position = snake->head->current_position;
+    
+    snake->head->next_position = (Vector2){
+        snake->head->current_position.x + snake->head->direction.x * TILE_SIZE,
+        snake->head->current_position.y + snake->head->direction.y * TILE_SIZE
+    };
+
+    snake->tail->direction = GetTailDirection(snake->tail);
+
+    snake->tail->previous_position = snake->tail->current_position;
+
+    snake->tail->next_position = (Vector2){
+        snake->tail->current_position.x + snake->tail->direction.x * TILE_SIZE,
+        snake->tail->current_position.y + snake->tail->direction.y * TILE_SIZE
+    };
+}
+
+void input(Snake *snake,SDL_Event event){
+    Vector2 new_direction = {0.0f};
+
+    if(event.key.keysym.scancode == SDL_SCANCODE_W)      new_direction.y = -1.0f;
+    else if(event.key.keysym.scancode == SDL_SCANCODE_S) new_direction.y = 1.0f;
+    else if(event.key.keysym.scancode == SDL_SCANCODE_A) new_direction.x = -1.0f;
+    else if(event.key.keysym.scancode == SDL_SCANCODE_D) new_direction.x = 1.0f;
+
+    if(!new_direction.x && !new_direction.y) return;
+
+    QueueTurn(snake,new_direction);
+
+    if(!snake->moving){
+        snake->moving = true;
+        SnakeNextMove(snake);
+    }
+}
+
+//each turn is checked against the heading the snake will have once the turns before it are taken,
+//repeating that heading does nothing and reversing it would run the head into the neck
+void QueueTurn(Snake *snake,Vector2 direction){
+    TurnQueue *turns = &snake->turns;
+    Vector2 heading = (turns->count > 0) ? turns->turns[(turns->first + turns->count - 1) % TURN_QUEUE] : snake->buffer_direction;
+
+    if(direction.x == heading.x && direction.y == heading.y){
+        turns->coalesced++;
+        return;
+    }
+    if(direction.x == -heading.x && direction.y == -heading.y){
+        turns->reversed++;
+        return;
+    }
+    if(turns->count == TURN_QUEUE){
+        turns->dropped++;
+        return;
+    }
+
+    turns->turns[(turns->first + turns->count) % TURN_QUEUE] = direction;
+    turns->count++;
+    turns->queued++;
+}
+
+//the direction the head takes when the current step completes
+Vector2 GetNextTurn(Snake *snake){
+    if(snake->turns.count > 0) return snake->turns.turns[snake->turns.first];
+    return snake->buffer_direction;
+}
+
+typedef struct _Latch{
+    Snake *snake;
+    int latched;
+}Latch;
+
+//applies and drops the direction keys, everything else is kept
+static int LatchFilter(void *data,SDL_Event *event){
+    if(event->type != SDL_KEYDOWN) return 1;
+
+    SDL_Scancode scancode = event->key.keysym.scancode;
+    if(scancode != SDL_SCANCODE_W && scancode != SDL_SCANCODE_S && scancode != SDL_SCANCODE_A && scancode != SDL_SCANCODE_D) return 1;
+
+    Latch *latch = data;
+    input(latch->snake,*event);
+    latch->latched++;
+    return 0;
+}
+
+//takes the direction keys that arrived since the events were polled, in the order they were pressed,
+//the other events stay queued in their order for the next poll
+int LatchInput(Snake *snake){
+    Latch latch = {snake,0};
+    SDL_PumpEvents();
+    SDL_FilterEvents(LatchFilter,&latch);
+    return latch.latched;
+}
+
+//where the head will be lead pixels of movement from now, turning into the pending direction past the end of the step
+//only what is drawn moves ahead, the step still applies the direction when it completes
+Vector2 GetLatchedHeadPosition(Snake *snake,float lead){
+    Piece *head = snake->head;
+    Vector2 position = head->current_position;
+    if(!snake->moving || (!head->direction.x && !head->direction.y)) return position;
+
+    if(lead > TILE_SIZE) lead = TILE_SIZE;
+    float remaining = fabsf(head->next_position.x - position.x) + fabsf(head->next_position.y - position.y);
+
+    Vector2 direction = head->direction;
+    if(lead <= remaining){
+        position.x += direction.x * lead;
+        position.y += direction.y * lead;
+    }
+    else{
+        //the solver picks its next direction only when the step completes, so its head stops at the cell
+        direction = (snake->solver == NULL) ? GetNextTurn(snake) : (Vector2){0.0f,0.0f};
+        position.x = head->next_position.x + direction.x * (lead - remaining);
+        position.y = head->next_position.y + direction.y * (lead - remaining);
+    }
+
+    if(position.x < 0.0f && direction.x < 0.0f) position.x += columns * TILE_SIZE;
+    else if(position.x + TILE_SIZE > columns * TILE_SIZE && direction.x > 0.0f) position.x -= columns * TILE_SIZE;
+
+    if(position.y < 0.0f && direction.y < 0.0f) position.y += rows * TILE_SIZE;
+    else if(position.y + TILE_SIZE > rows * TILE_SIZE && direction.y > 0.0f) position.y -= rows * TILE_SIZE;
+
+    return position;
+}
+
+void PutTailOnHead(Snake *snake){
+    Piece *tail = snake->tail;
+
+    snake->tail = tail->previous;
+    snake->tail->next = NULL;
+
+    snake->head->previous = tail;
+    tail->next = snake->head;
+    tail->previous = NULL;
+    tail->current_position = snake->head->current_position;
+
+    snake->head = tail;
+    snake->body = snake->head;
+}
+
+void PieceMove(Piece *piece,float delta_time){
+    //a piece that reaches its cell in this call loses its direction, the wrap still needs the one it moved in
+    Vector2 direction = piece->direction;
+    float distanci_x = fabsf(piece->next_position.x - piece->current_position.x);
+    float distanci_y = fabsf(piece->next_position.y - piece->current_position.y);
+
+    if(distanci_x > VELOCITY * delta_time){
+        piece->current_position.x += piece->direction.x * VELOCITY * delta_time;
+    }
+    else if(distanci_y > VELOCITY * delta_time){
+        piece->current_position.y += piece->direction.y * VELOCITY * delta_time;
+    }
+    else{
+        piece->current_position = piece->next_position;
+        piece->direction = (Vector2){0.0f};
+    }
+
+    if(piece->current_position.x < 0.0f && direction.x < 0.0f){
+        piece->current_position.x += columns * TILE_SIZE;
+        piece->next_position.x += columns * TILE_SIZE;
+    }
+    else if(piece->current_position.x+TILE_SIZE > columns * TILE_SIZE && direction.x > 0.0f){
+        piece->current_position.x -= columns * TILE_SIZE;
+        piece->next_position.x -= columns * TILE_SIZE;
+    }
+
+    if(piece->current_position.y < 0.0f && direction.y < 0.0f){
+        piece->current_position.y += rows * TILE_SIZE;
+        piece->next_position.y += rows * TILE_SIZE;
+    }
+    else if(piece->current_position.y+TILE_SIZE > rows * TILE_SIZE && direction.y > 0.0f){
+        piece->current_position.y -= rows * TILE_SIZE;
+        piece->next_position.y -= rows * TILE_SIZE;
+    }
+}
+
+void SnakeMove(Snake *snake,Vector2 *point,float delta_time){
+    if(!snake->moving) return;
+
+    //anything that moves on screen bumps the version, a zero step changes nothing
+    if(delta_time > 0.0f) snake->version++;
+
+    PieceMove(snake->head,delta_time);
+    PieceMove(snake->tail,delta_time);
+
+    if((!snake->head->direction.x && !snake->head->direction.y) && (!snake->tail->direction.x && !snake->tail->direction.y)){
+        
+        PutTailOnHead(snake);
+        snake->steps++;
+
+        bool grew = false;
+        if(snake->head->current_position.x == point->x && snake->head->current_position.y == point->y){
+            GetPointPosition(point);
+
+            Piece new_piece = {{0.0f},snake->head->previous_position,snake->head->previous_position,snake->head->previous_position,NULL,NULL};
+
+            snake->tail = AddPiece(&snake->body,new_piece);
+            snake->length++;
+            grew = true;
+        }
+
+        //the new head still holds the cell it left as the old tail
+        snake->changes[snake->steps % STEP_LOG] = (StepChange){
+            GetCell(snake->head->current_position),
+            GetCell(snake->head->previous_position),
+            GetCell(snake->tail->current_position),
+            grew
+        };
+
+        if(snake->solver != NULL){
+            SolverUpdate(snake->solver,snake,point);
+        }
+
+        SnakeNextMove(snake);
+    }
+}
+
+//moves the snake by delta_time in pieces no longer than one step, so a long frame or a fast time scale
+//still walks it cell by cell, time past MAX_FRAME_STEPS steps is dropped
+//returns how many pieces it grew by and sets eaten to the last food taken
+int SnakeAdvance(Snake *snake,Vector2 *point,float delta_time,Vector2 *eaten){
+    float step = (float)TILE_SIZE / VELOCITY;
+    int grown = 0;
+
+    for(int i=0; i<MAX_FRAME_STEPS && delta_time > 0.0f && snake->moving; ++i){
+        float time = fminf(delta_time,step);
+        Vector2 food = *point;
+        int length = snake->length;
+
+        SnakeMove(snake,point,time);
+        if(snake->length > length){
+            *eaten = food;
+            grown += snake->length - length;
+        }
+        delta_time -= time;
+    }
+
+    return grown;
+}
+
+//painter's order for same sized blocks on the board is the diagonal x + y, counted in half cells
+//so a piece sliding between two diagonals sorts between them
+int GetDepth(Vector2 position){
+    return (int)floorf((position.x + position.y) * 2.0f / TILE_SIZE);
+}
+
+//queues the snake and the food by diagonal, on the same diagonal the sliding head and tail go after the
+//resting pieces and the food goes last, so it stays visible even when it spawns under the body
+void DrawObjects(RenderQueue *queue,Snake *snake,Vector2 *point,Camera *camera,Atlas *atlas){
+    Rect point_sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_POINT]);
+    Rect piece_sprite = AtlasGetBlock(atlas,atlas->sprites[SPRITE_PIECE]);
+    Rect dst;
+
+    for(Piece *piece = snake->head->next; piece != NULL && piece != snake->tail; piece = piece->next){
+        dst = GetScreenRect(camera,piece->current_position,0.0f);
+        if(RectVisible(camera,&dst)) RenderQueuePush(queue,RENDER_LAYER_OBJECTS,GetDepth(piece->current_position),atlas->texture,BLEND_NORMAL,&piece_sprite,&dst);
+    }
+
+    Vector2 positions[3] = {snake->tail->current_position,snake->head->current_position,*point};
+    for(int i=0; i<3; ++i){
+        dst = GetScreenRect(camera,positions[i],0.0f);
+        if(RectVisible(camera,&dst)) RenderQueuePush(queue,RENDER_LAYER_OBJECTS,GetDepth(positions[i]),atlas->texture,BLEND_NORMAL,i == 2 ? &point_sprite : &piece_sprite,&dst);
+    }
+}
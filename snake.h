@@ -0,0 +1,222 @@
+#ifndef SNAKE_H_
+#define SNAKE_H_
+
+#include "gpu_stats.h"
+#include <time.h>
+
+#include "render.h"
+#include "state.h"
+
+#define TILE_SIZE 16
+#define BLOCK_SIZE (TILE_SIZE*2)
+#define COLUMNS 30
+#define ROWS 30
+#define MIN_COLUMNS 3
+#define MIN_ROWS 1
+#define MAX_BOARD_SIZE 4096
+#define VELOCITY 150
+#define MIN_ZOOM (1.0f / 256.0f)
+#define MAX_ZOOM 4.0f
+#define ZOOM_STEP 1.25f
+#define TURN_QUEUE 4
+#define MIN_TIME_SCALE 0.25
+#define MAX_TIME_SCALE 1000.0
+#define MAX_FRAME_STEPS 4096
+#define STEP_LOG MAX_FRAME_STEPS
+
+#define ATLAS_PADDING 1
+#define ATLAS_SLOT (BLOCK_SIZE + ATLAS_PADDING*2)
+#define ATLAS_COLUMNS 8
+#define ATLAS_ROWS 8
+#define ATLAS_SLOTS (ATLAS_COLUMNS * ATLAS_ROWS)
+#define ATLAS_BUCKETS 128
+
+extern int columns;
+extern int rows;
+
+typedef struct _Camera{
+    Vector2 translate;
+    float scale;
+    int width;
+    int height;
+}Camera;
+
+typedef struct _CellRange{
+    int u0,u1;
+    int v0,v1;
+}CellRange;
+
+typedef struct _Piece{
+    Vector2 direction;
+    Vector2 current_position;
+    Vector2 next_position;
+    Vector2 previous_position;
+
+    struct _Piece *next;
+    struct _Piece *previous;
+}Piece;
+
+typedef enum _Sprite{
+    SPRITE_FLOOR,
+    SPRITE_PIECE,
+    SPRITE_POINT,
+    SPRITE_COUNT,
+}Sprite;
+
+typedef struct _SpriteKey{
+    Color border_color;
+    Color fill_color;
+    int size;
+}SpriteKey;
+
+typedef struct _Atlas{
+    Renderer *renderer;
+    RenderState *state;
+    Texture *texture;
+
+    int count;
+    uint64_t clock;
+    SpriteKey keys[ATLAS_SLOTS];
+    uint64_t last_used[ATLAS_SLOTS];
+    int next[ATLAS_SLOTS];
+    int buckets[ATLAS_BUCKETS];
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+
+    SpriteKey sprites[SPRITE_COUNT];
+}Atlas;
+
+typedef struct _DepthItem{
+    Rect src;
+    Rect dst;
+    int depth;
+    int index;
+}DepthItem;
+
+typedef struct _Solver{
+    int count;
+    int *cycle;
+    int *cells;
+}Solver;
+
+//the cells one step changed, the head came to rest on entered, the old tail left vacated
+//and, unless the snake grew, the piece now on tail stopped resting there
+typedef struct _StepChange{
+    int entered;
+    int vacated;
+    int tail;
+    bool grew;
+}StepChange;
+
+//turns in the order they were pressed, one is taken by each step
+typedef struct _TurnQueue{
+    Vector2 turns[TURN_QUEUE];
+    int first;
+    int count;
+
+    uint64_t queued;
+    uint64_t coalesced;
+    uint64_t reversed;
+    uint64_t dropped;
+}TurnQueue;
+
+typedef struct _Snake{
+    bool moving;
+    int length;
+    uint64_t steps;
+    uint64_t version;
+    Vector2 buffer_direction;
+    StepChange changes[STEP_LOG];
+    TurnQueue turns;
+    Piece *body;
+    Piece *head;
+    Piece *tail;
+    Solver *solver;
+}Snake;
+
+void GetPointPosition(Vector2 *point);
+
+Vector2 GetIsometricPosition(float x,float y);
+
+int GetCell(Vector2 position);
+
+
+void CameraCenter(Camera *camera,int width,int height);
+
+void CameraZoom(Camera *camera,float factor);
+
+Camera GetScaledCamera(Camera *camera,float resolution);
+
+Rect GetScreenRect(Camera *camera,Vector2 position,float lift);
+
+bool RectVisible(Camera *camera,Rect *rect);
+
+CellRange GetVisibleCells(Camera *camera,float lift);
+
+void GetDiagonalCells(CellRange *range,int v,int *x0,int *x1);
+
+
+Piece* AddPiece(Piece **body,Piece source);
+
+Snake* CreateSnake();
+
+Snake* CreateSnakeOfLength(int length);
+
+void SnakeFree(Snake *snake);
+
+
+void DrawBlock(Renderer *renderer,Vector2 position,float size,Color border_color,Color fill_color);
+
+void DrawFloor(RenderQueue *queue,Camera *camera,Atlas *atlas);
+
+void DrawObjects(RenderQueue *queue,Snake *snake,Vector2 *point,Camera *camera,Atlas *atlas);
+
+
+int GetDepth(Vector2 position);
+
+
+Atlas* CreateAtlas(RenderState *state);
+
+void AtlasFree(Atlas *atlas);
+
+Rect GetAtlasSlot(int slot);
+
+Rect AtlasGetBlock(Atlas *atlas,SpriteKey key);
+
+
+Solver* CreateSolver();
+
+void SolverFree(Solver *solver);
+
+int CycleDistance(Solver *solver,int from,int to);
+
+Vector2 GetCellDirection(int from,int to);
+
+void SolverUpdate(Solver *solver,Snake *snake,Vector2 *point);
+
+
+Vector2 GetTailDirection(Piece *tail);
+
+void SnakeNextMove(Snake *snake);
+
+void input(Snake *snake,SDL_Event event);
+
+void QueueTurn(Snake *snake,Vector2 direction);
+
+Vector2 GetNextTurn(Snake *snake);
+
+int LatchInput(Snake *snake);
+
+Vector2 GetLatchedHeadPosition(Snake *snake,float lead);
+
+void PutTailOnHead(Snake *snake);
+
+void PieceMove(Piece *piece,float delta_time);
+
+void SnakeMove(Snake *snake,Vector2 *point,float delta_time);
+
+int SnakeAdvance(Snake *snake,Vector2 *point,float delta_time,Vector2 *eaten);
+
+#endif
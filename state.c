@@ -0,0 +1,111 @@
+#include "state.h"
+
+//a shadow copy of the renderer state, a call that would set what is already set never reaches the backend
+//blend mode, clip and viewport belong to each target and the filter to each texture, NULL is the screen
+//a state is only known after it was set through here, so the first call for a texture always goes through
+
+RenderState* CreateRenderState(Renderer *renderer){
+    RenderState *state = malloc(sizeof(RenderState));
+    state->renderer = renderer;
+    state->target = NULL;
+    state->target_known = true;
+
+    state->count = 0;
+    state->next = 0;
+
+    state->frame = (StateStats){0,0};
+    state->last = (StateStats){0,0};
+    return state;
+}
+
+void RenderStateFree(RenderState *state){
+    free(state);
+}
+
+static TextureState* GetTextureState(RenderState *state,Texture *texture){
+    for(int i=0; i<state->count; ++i){
+        if(state->textures[i].texture == texture) return &state->textures[i];
+    }
+
+    //a full table forgets the oldest entry, which only costs a call that can't be elided
+    TextureState *entry;
+    if(state->count < STATE_TEXTURES) entry = &state->textures[state->count++];
+    else{
+        entry = &state->textures[state->next];
+        state->next = (state->next + 1) % STATE_TEXTURES;
+    }
+    entry->texture = texture;
+    entry->known = 0;
+    return entry;
+}
+
+//must be called before a texture is freed, a new texture at the same address starts with the defaults again
+void StateForget(RenderState *state,Texture *texture){
+    for(int i=0; i<state->count; ++i){
+        if(state->textures[i].texture == texture) state->textures[i].known = 0;
+    }
+    if(state->target == texture) state->target_known = false;
+}
+
+static bool StateElide(RenderState *state,bool same){
+    if(same) state->frame.elided++;
+    else state->frame.calls++;
+    return same;
+}
+
+void StateSetTarget(RenderState *state,Texture *target){
+    if(StateElide(state,state->target_known && state->target == target)) return;
+    state->target = target;
+    state->target_known = true;
+    RendererSetTarget(state->renderer,target);
+}
+
+void StateSetBlendMode(RenderState *state,Texture *target,BlendModePreset preset){
+    TextureState *entry = GetTextureState(state,target);
+    if(StateElide(state,(entry->known & STATE_BLEND) && entry->blend == preset)) return;
+    entry->known |= STATE_BLEND;
+    entry->blend = preset;
+    SetBlendModeByPreset(state->renderer,target,preset);
+}
+
+void StateSetClip(RenderState *state,Texture *target,Rect *rect){
+    TextureState *entry = GetTextureState(state,target);
+    if(StateElide(state,(entry->known & STATE_CLIP) && entry->clipping && memcmp(&entry->clip,rect,sizeof(Rect)) == 0)) return;
+    entry->known |= STATE_CLIP;
+    entry->clipping = true;
+    entry->clip = *rect;
+    SetClip(state->renderer,target,rect);
+}
+
+void StateUnSetClip(RenderState *state,Texture *target){
+    TextureState *entry = GetTextureState(state,target);
+    if(StateElide(state,(entry->known & STATE_CLIP) && !entry->clipping)) return;
+    entry->known |= STATE_CLIP;
+    entry->clipping = false;
+    UnSetClip(state->renderer,target);
+}
+
+void StateSetViewport(RenderState *state,Texture *target,Rect *rect){
+    TextureState *entry = GetTextureState(state,target);
+    bool same = (entry->known & STATE_VIEWPORT) && entry->has_viewport == (rect != NULL) &&
+                (rect == NULL || memcmp(&entry->viewport,rect,sizeof(Rect)) == 0);
+    if(StateElide(state,same)) return;
+    entry->known |= STATE_VIEWPORT;
+    entry->has_viewport = rect != NULL;
+    if(rect != NULL) entry->viewport = *rect;
+    RendererSetViewport(state->renderer,target,rect);
+}
+
+void StateSetTextureFilter(RenderState *state,Texture *texture,Filter min_filter,Filter mag_filter){
+    TextureState *entry = GetTextureState(state,texture);
+    if(StateElide(state,(entry->known & STATE_FILTER) && entry->min_filter == min_filter && entry->mag_filter == mag_filter)) return;
+    entry->known |= STATE_FILTER;
+    entry->min_filter = min_filter;
+    entry->mag_filter = mag_filter;
+    SetTextureFilter(texture,min_filter,mag_filter);
+}
+
+void StateEndFrame(RenderState *state){
+    state->last = state->frame;
+    state->frame = (StateStats){0,0};
+}
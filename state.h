@@ -0,0 +1,65 @@
+#ifndef STATE_H_
+#define STATE_H_
+
+#include "gpu_stats.h"
+
+#define STATE_TEXTURES 32
+
+#define STATE_BLEND 0x01
+#define STATE_CLIP 0x02
+#define STATE_VIEWPORT 0x04
+#define STATE_FILTER 0x08
+
+typedef struct _TextureState{
+    Texture *texture;
+    int known;
+
+    BlendModePreset blend;
+    bool clipping;
+    Rect clip;
+    bool has_viewport;
+    Rect viewport;
+    Filter min_filter;
+    Filter mag_filter;
+}TextureState;
+
+typedef struct _StateStats{
+    uint64_t calls;
+    uint64_t elided;
+}StateStats;
+
+typedef struct _RenderState{
+    Renderer *renderer;
+    Texture *target;
+    bool target_known;
+
+    TextureState textures[STATE_TEXTURES];
+    int count;
+    int next;
+
+    StateStats frame;
+    StateStats last;
+}RenderState;
+
+
+RenderState* CreateRenderState(Renderer *renderer);
+
+void RenderStateFree(RenderState *state);
+
+void StateForget(RenderState *state,Texture *texture);
+
+void StateSetTarget(RenderState *state,Texture *target);
+
+void StateSetBlendMode(RenderState *state,Texture *target,BlendModePreset preset);
+
+void StateSetClip(RenderState *state,Texture *target,Rect *rect);
+
+void StateUnSetClip(RenderState *state,Texture *target);
+
+void StateSetViewport(RenderState *state,Texture *target,Rect *rect);
+
+void StateSetTextureFilter(RenderState *state,Texture *texture,Filter min_filter,Filter mag_filter);
+
+void StateEndFrame(RenderState *state);
+
+#endif